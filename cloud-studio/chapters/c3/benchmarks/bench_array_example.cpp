@@ -0,0 +1,113 @@
+/**
+ * @file bench_array_example.cpp
+ * @brief 统计 ArrayExample 各种拷贝/移动操作每次复制的字节数、分配次数和耗时
+ *
+ * 编译运行：clang++ -std=c++17 -O2 bench_array_example.cpp -o bench && ./bench
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "../tutorials/array_example.h"
+
+// 统计 new[] 的调用次数，用来观察缓冲区复用
+static size_t allocationCount = 0;
+
+auto operator new[](size_t bytes) -> void* {
+  ++allocationCount;
+  return ::operator new(bytes);
+}
+
+void operator delete[](void* p) noexcept { ::operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { ::operator delete(p); }
+
+static volatile int sink = 0;
+
+template<typename Fn> void measure(const char* name, size_t iterations, Fn fn) {
+  const size_t bytesBefore = ArrayExample::copiedBytes;
+  const size_t allocBefore = allocationCount;
+  const auto   start       = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    fn();
+  }
+  const auto   stop   = std::chrono::steady_clock::now();
+  const double ns     = std::chrono::duration<double, std::nano>(stop - start).count();
+  const double bytes  = static_cast<double>(ArrayExample::copiedBytes - bytesBefore);
+  const double allocs = static_cast<double>(allocationCount - allocBefore);
+  std::printf(
+    "%-28s %12.0f bytes/op %8.2f allocs/op %10.1f ns/op\n",
+    name,
+    bytes / iterations,
+    allocs / iterations,
+    ns / iterations);
+}
+
+auto main() -> int {
+  constexpr size_t kElements   = 4096;
+  constexpr size_t kIterations = 20000;
+
+  ArrayExample source(kElements);
+  std::fill(source.data, source.data + source.size, 7);
+  ArrayExample smaller(kElements / 2);
+  std::fill(smaller.data, smaller.data + smaller.size, 3);
+
+  std::printf("ArrayExample with %zu ints (%zu bytes)\n", kElements, kElements * sizeof(int));
+
+  measure("copy construct", kIterations, [&] {
+    ArrayExample copy(source);
+    sink = copy.data[0];
+  });
+
+  ArrayExample target(kElements);
+  measure("copy assign (same size)", kIterations, [&] {
+    target = source;
+    sink   = target.data[0];
+  });
+
+  measure("copy assign (smaller)", kIterations, [&] {
+    target = smaller;
+    sink   = target.data[0];
+  });
+
+  measure("move construct", kIterations, [&] {
+    ArrayExample moved(std::move(target));
+    sink   = moved.data[0];
+    target = std::move(moved);
+  });
+
+  measure("return by value", kIterations, [&] {
+    auto make = [&]() -> ArrayExample {
+      ArrayExample result(source);
+      return result;
+    };
+    ArrayExample made = make();
+    sink              = made.data[0];
+  });
+
+  measure("vector push_back x16", kIterations / 16, [&] {
+    std::vector<ArrayExample> arrays;
+    for (size_t i = 0; i < 16; ++i) {
+      arrays.emplace_back(kElements);
+    }
+    sink = arrays.back().data[0];
+  });
+
+  DerivedArrayExample derivedSource(kElements, 1);
+  std::fill(derivedSource.data, derivedSource.data + derivedSource.size, 9);
+  measure("derived copy construct", kIterations, [&] {
+    DerivedArrayExample copy(derivedSource);
+    sink = copy.data[0] + copy.extra;
+  });
+
+  DerivedArrayExample derivedTarget(kElements, 2);
+  measure("derived copy assign", kIterations, [&] {
+    derivedTarget = derivedSource;
+    sink          = derivedTarget.data[0];
+  });
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file bench_huge_array.cpp
+ * @brief 比较 HugeArrayExample（mmap）与 ArrayExample（new int[]）的构造、拷贝和扩容（仅限 Linux）
+ *
+ * 编译运行：clang++ -std=c++17 -O2 bench_huge_array.cpp -o bench && ./bench
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "../tutorials/array_example.h"
+#include "../tutorials/huge_array.h"
+
+static volatile int sink = 0;
+
+template<typename Fn> auto milliseconds(Fn fn) -> double {
+  const auto start = std::chrono::steady_clock::now();
+  fn();
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// 每隔 stride 个元素写一次，模拟稀疏使用的大数组
+template<typename Array> void touch(Array& array, size_t stride) {
+  for (size_t i = 0; i < array.size; i += stride) {
+    array.data[i] = static_cast<int>(i);
+  }
+}
+
+auto main() -> int {
+  constexpr size_t kFourGiB  = (size_t{4} << 30) / sizeof(int);
+  constexpr size_t kElements = (size_t{512} << 20) / sizeof(int);
+  const size_t     kPageInts = static_cast<size_t>(::sysconf(_SC_PAGESIZE)) / sizeof(int);
+
+  std::printf("== construct 4 GiB ==\n");
+  {
+    HugeArrayExample huge;
+    std::printf("HugeArrayExample: %.3f ms\n", milliseconds([&] {
+                  huge = HugeArrayExample(kFourGiB);
+                }));
+    sink = huge.data[kFourGiB - 1];
+    std::printf("resident after construct: %zu bytes\n", huge.residentBytes());
+  }
+
+  std::printf("\n== copy 512 MiB, 1 of every 64 pages touched ==\n");
+  {
+    ArrayExample plain(kElements);
+    touch(plain, kPageInts * 64);
+    HugeArrayExample huge(kElements);
+    touch(huge, kPageInts * 64);
+
+    std::printf("ArrayExample:     %.3f ms\n", milliseconds([&] {
+                  ArrayExample copy(plain);
+                  sink = copy.data[0];
+                }));
+    std::printf("HugeArrayExample: %.3f ms\n", milliseconds([&] {
+                  HugeArrayExample copy(huge);
+                  sink = copy.data[0];
+                  std::printf("copy resident: %zu bytes\n", copy.residentBytes());
+                }));
+  }
+
+  std::printf("\n== copy 512 MiB, every page touched ==\n");
+  {
+    ArrayExample plain(kElements);
+    touch(plain, kPageInts);
+    HugeArrayExample huge(kElements);
+    touch(huge, kPageInts);
+
+    std::printf("ArrayExample:     %.3f ms\n", milliseconds([&] {
+                  ArrayExample copy(plain);
+                  sink = copy.data[0];
+                }));
+    std::printf("HugeArrayExample: %.3f ms\n", milliseconds([&] {
+                  HugeArrayExample copy(huge);
+                  sink = copy.data[0];
+                }));
+  }
+
+  std::printf("\n== construct + touch every page of 512 MiB ==\n");
+  {
+    std::printf("HugeArrayExample (THP): %.3f ms\n", milliseconds([&] {
+                  HugeArrayExample thp(kElements, true);
+                  touch(thp, kPageInts);
+                  sink = thp.data[0];
+                }));
+    std::printf("HugeArrayExample (4K):  %.3f ms\n", milliseconds([&] {
+                  HugeArrayExample small(kElements, false);
+                  touch(small, kPageInts);
+                  sink = small.data[0];
+                }));
+  }
+
+  std::printf("\n== grow 512 MiB -> 1 GiB ==\n");
+  {
+    ArrayExample plain(kElements);
+    touch(plain, kPageInts);
+    HugeArrayExample huge(kElements);
+    touch(huge, kPageInts);
+
+    std::printf("ArrayExample (new + copy): %.3f ms\n", milliseconds([&] {
+                  ArrayExample bigger(kElements * 2);
+                  std::copy(plain.data, plain.data + plain.size, bigger.data);
+                  sink = bigger.data[0];
+                }));
+    std::printf("HugeArrayExample (mremap): %.3f ms\n", milliseconds([&] {
+                  huge.resize(kElements * 2);
+                  sink = huge.data[0];
+                }));
+  }
+
+  std::printf("\n== file-backed persistence ==\n");
+  {
+    const std::string path = "/tmp/huge_array_bench.bin";
+    {
+      auto persisted = HugeArrayExample::mapFile(path, kElements);
+      touch(persisted, kPageInts * 64);
+      std::printf("sync: %.3f ms\n", milliseconds([&] { persisted.sync(); }));
+    }
+    auto reopened = HugeArrayExample::mapFile(path, kElements);
+    std::printf("reopened value at page 64: %d\n", reopened.data[kPageInts * 64]);
+    ::unlink(path.c_str());
+  }
+  return 0;
+}
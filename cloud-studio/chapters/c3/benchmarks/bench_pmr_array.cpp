@@ -0,0 +1,90 @@
+/**
+ * @file bench_pmr_array.cpp
+ * @brief 比较 Array<int> 在默认分配器、pmr 单调分配区和 pmr 池分配器下的耗时
+ *
+ * 模拟一个请求：创建 kArraysPerRequest 个大小不一的数组，填充、求和，请求结束时全部销毁。
+ *
+ * 编译运行：clang++ -std=c++17 -O2 bench_pmr_array.cpp -o bench && ./bench
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../tutorials/allocator_array.h"
+#include "../tutorials/array_example.h"
+
+static volatile long long sink = 0;
+
+constexpr size_t kRequests         = 20000;
+constexpr size_t kArraysPerRequest = 32;
+
+template<typename MakeArray> void handleRequest(const std::vector<size_t>& sizes, MakeArray make) {
+  long long sum = 0;
+  for (size_t size : sizes) {
+    auto array = make(size);
+    std::iota(array.begin(), array.end(), 0);
+    sum += std::accumulate(array.begin(), array.end(), 0LL);
+  }
+  sink = sum;
+}
+
+template<typename Fn> void measure(const char* name, const std::vector<std::vector<size_t>>& requests, Fn fn) {
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto& sizes : requests) {
+    fn(sizes);
+  }
+  const auto   stop = std::chrono::steady_clock::now();
+  const double ns   = std::chrono::duration<double, std::nano>(stop - start).count();
+  std::printf("%-34s %10.1f ns/request\n", name, ns / requests.size());
+}
+
+auto main() -> int {
+  std::mt19937                          rng(42);
+  std::uniform_int_distribution<size_t> sizeDist(4, 64);
+  std::vector<std::vector<size_t>>      requests(kRequests);
+  for (auto& sizes : requests) {
+    for (size_t i = 0; i < kArraysPerRequest; ++i) {
+      sizes.push_back(sizeDist(rng));
+    }
+  }
+
+  measure("ArrayExample (new int[])", requests, [](const std::vector<size_t>& sizes) {
+    long long sum = 0;
+    for (size_t size : sizes) {
+      ArrayExample array(size);
+      std::iota(array.data, array.data + array.size, 0);
+      sum += std::accumulate(array.data, array.data + array.size, 0LL);
+    }
+    sink = sum;
+  });
+
+  measure("Array<int> (std::allocator)", requests, [](const std::vector<size_t>& sizes) {
+    handleRequest(sizes, [](size_t size) { return Array<int>(size); });
+  });
+
+  measure("PmrArray (monotonic, per request)", requests, [](const std::vector<size_t>& sizes) {
+    RequestArena<> arena;
+    handleRequest(sizes, [&arena](size_t size) { return arena.makeArray<int>(size); });
+  });
+
+  std::pmr::unsynchronized_pool_resource unsyncPool;
+  measure("PmrArray (unsynchronized pool)", requests, [&](const std::vector<size_t>& sizes) {
+    handleRequest(sizes, [&](size_t size) { return PmrArray<int>(size, &unsyncPool); });
+  });
+
+  std::pmr::synchronized_pool_resource syncPool;
+  measure("PmrArray (synchronized pool)", requests, [&](const std::vector<size_t>& sizes) {
+    handleRequest(sizes, [&](size_t size) { return PmrArray<int>(size, &syncPool); });
+  });
+
+  measure("PmrArray (new_delete_resource)", requests, [](const std::vector<size_t>& sizes) {
+    handleRequest(sizes, [](size_t size) {
+      return PmrArray<int>(size, std::pmr::new_delete_resource());
+    });
+  });
+  return 0;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file bench_small_array.cpp
+ * @brief 比较 ArrayExample 与不同内联容量的 SmallArrayExample 在 1 ~ 4096 个元素时的耗时
+ *
+ * 每次操作 = 构造 + 拷贝构造 + 移动构造 + 析构。
+ * 元素个数不超过内联容量时没有堆分配，超过后两者都走堆，交叉点就是内联容量。
+ *
+ * 编译运行：clang++ -std=c++17 -O2 bench_small_array.cpp -o bench && ./bench
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+#include "../tutorials/array_example.h"
+
+static volatile int sink = 0;
+
+template<typename Array> auto measure(size_t elements, size_t iterations) -> double {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    Array array(elements);
+    std::fill(array.data, array.data + array.size, static_cast<int>(i));
+    Array copy(array);
+    Array moved(std::move(copy));
+    sink = moved.data[elements - 1];
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+}
+
+auto main() -> int {
+  constexpr size_t kIterations = 200000;
+
+  std::printf(
+    "%8s %14s %14s %14s %14s\n",
+    "elements",
+    "ArrayExample",
+    "Small<16>",
+    "Small<64>",
+    "Small<256>");
+  for (size_t elements = 1; elements <= 4096; elements *= 2) {
+    const size_t iterations = elements >= 1024 ? kIterations / 10 : kIterations;
+    std::printf(
+      "%8zu %11.1f ns %11.1f ns %11.1f ns %11.1f ns\n",
+      elements,
+      measure<ArrayExample>(elements, iterations),
+      measure<SmallArrayExample<16>>(elements, iterations),
+      measure<SmallArrayExample<64>>(elements, iterations),
+      measure<SmallArrayExample<256>>(elements, iterations));
+  }
+
+  std::printf(
+    "\nsizeof: ArrayExample=%zu Small<16>=%zu Small<64>=%zu Small<256>=%zu\n",
+    sizeof(ArrayExample),
+    sizeof(SmallArrayExample<16>),
+    sizeof(SmallArrayExample<64>),
+    sizeof(SmallArrayExample<256>));
+  return 0;
+}
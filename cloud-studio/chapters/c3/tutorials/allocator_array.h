@@ -0,0 +1,267 @@
+#ifndef __ALLOCATOR_ARRAY__H
+#define __ALLOCATOR_ARRAY__H
+
+/**
+ * @file allocator_array.h
+ * @brief ArrayExample / GoodCase 的通用版本：元素类型和分配器都可以替换
+ *
+ * - Array<T, Alloc> 通过 std::allocator_traits 分配、构造和销毁元素，
+ *   遵守 propagate_on_container_* 的约定，因此可以接入 arena、NUMA、大页等自定义分配器
+ * - PmrArray<T> 使用 std::pmr::polymorphic_allocator，运行时选择 memory_resource
+ * - RequestArena 是请求级别的单调分配区：数组的内存从栈上缓冲区（不够时再从上游）顺序切分，
+ *   释放是空操作，整个请求结束时一次性回收
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+// 这两种分配器的 construct 对平凡类型等价于 placement new，可以批量初始化/复制
+template<typename A> struct HasPlainConstruct : std::false_type {};
+template<typename U> struct HasPlainConstruct<std::allocator<U>> : std::true_type {};
+template<typename U>
+struct HasPlainConstruct<std::pmr::polymorphic_allocator<U>> : std::true_type {};
+
+template<typename T, typename Alloc = std::allocator<T>> class Array {
+  using Traits = std::allocator_traits<Alloc>;
+
+  static constexpr bool kBulkInit = HasPlainConstruct<Alloc>::value && std::is_trivial_v<T>;
+
+  public:
+  using value_type     = T;
+  using allocator_type = Alloc;
+  using size_type      = size_t;
+  using iterator       = T*;
+  using const_iterator = const T*;
+
+  Array() noexcept(noexcept(Alloc()))
+    : Array(Alloc()) {}
+
+  explicit Array(const Alloc& alloc) noexcept
+    : alloc_(alloc) {}
+
+  // 元素做值初始化（int 为 0）
+  explicit Array(size_t size, const Alloc& alloc = Alloc())
+    : alloc_(alloc) {
+    T* p = allocate(size);
+    if constexpr (kBulkInit) {
+      std::uninitialized_value_construct_n(p, size);
+    }
+    else {
+      constructFrom(p, size, [](T* slot, size_t, Alloc& a) { Traits::construct(a, slot); });
+    }
+    data_ = p;
+    size_ = size;
+  }
+
+  Array(size_t size, const T& value, const Alloc& alloc = Alloc())
+    : alloc_(alloc) {
+    T* p = allocate(size);
+    constructFrom(
+      p, size, [&value](T* slot, size_t, Alloc& a) { Traits::construct(a, slot, value); });
+    data_ = p;
+    size_ = size;
+  }
+
+  // 拷贝构造：分配器由 select_on_container_copy_construction 决定
+  // （polymorphic_allocator 会回到默认 memory_resource）
+  Array(const Array& other)
+    : Array(other, Traits::select_on_container_copy_construction(other.alloc_)) {}
+
+  Array(const Array& other, const Alloc& alloc)
+    : alloc_(alloc) {
+    copyFrom(other);
+  }
+
+  Array(Array&& other) noexcept
+    : alloc_(std::move(other.alloc_))
+    , data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0)) {}
+
+  // 指定分配器的移动构造：分配器不相等时只能逐个移动元素
+  Array(Array&& other, const Alloc& alloc)
+    : alloc_(alloc) {
+    if (alloc_ == other.alloc_) {
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    else {
+      moveFrom(other);
+    }
+  }
+
+  ~Array() { reset(); }
+
+  auto operator=(const Array& other) -> Array& {
+    if (this == &other) {
+      return *this;
+    }
+    if constexpr (Traits::propagate_on_container_copy_assignment::value) {
+      if (alloc_ != other.alloc_) {
+        reset();   // 旧内存必须用旧分配器释放
+      }
+      alloc_ = other.alloc_;
+    }
+    if (size_ == other.size_) {
+      // 大小相同：逐个拷贝赋值，复用已有内存
+      std::copy(other.begin(), other.end(), data_);
+    }
+    else {
+      Array copy(other, alloc_);
+      swapStorage(copy);
+    }
+    return *this;
+  }
+
+  auto operator=(Array&& other) noexcept(
+    Traits::propagate_on_container_move_assignment::value || Traits::is_always_equal::value)
+    -> Array& {
+    if (this == &other) {
+      return *this;
+    }
+    if constexpr (Traits::propagate_on_container_move_assignment::value) {
+      reset();
+      alloc_ = std::move(other.alloc_);
+      data_  = std::exchange(other.data_, nullptr);
+      size_  = std::exchange(other.size_, 0);
+    }
+    else if (alloc_ == other.alloc_) {
+      reset();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    else {
+      // 分配器不同又不能传播：在自己的分配器上逐个移动
+      Array moved(std::move(other), alloc_);
+      swapStorage(moved);
+    }
+    return *this;
+  }
+
+  void swap(Array& other) noexcept {
+    if constexpr (Traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+    }
+    swapStorage(other);
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return size_; }
+  [[nodiscard]] auto empty() const -> bool { return size_ == 0; }
+  [[nodiscard]] auto data() -> T* { return data_; }
+  [[nodiscard]] auto data() const -> const T* { return data_; }
+  [[nodiscard]] auto get_allocator() const -> Alloc { return alloc_; }
+
+  auto operator[](size_t i) -> T& { return data_[i]; }
+  auto operator[](size_t i) const -> const T& { return data_[i]; }
+
+  auto begin() -> iterator { return data_; }
+  auto end() -> iterator { return data_ + size_; }
+  [[nodiscard]] auto begin() const -> const_iterator { return data_; }
+  [[nodiscard]] auto end() const -> const_iterator { return data_ + size_; }
+
+  [[nodiscard]] auto sharesDataWith(const Array& other) const -> bool {
+    return data_ != nullptr && data_ == other.data_;
+  }
+
+  private:
+  Alloc  alloc_;
+  T*     data_ = nullptr;
+  size_t size_ = 0;
+
+  auto allocate(size_t size) -> T* {
+    return size == 0 ? nullptr : Traits::allocate(alloc_, size);
+  }
+
+  // 逐个构造元素；中途抛出异常时销毁已构造的元素并释放内存
+  template<typename Construct> void constructFrom(T* p, size_t size, Construct construct) {
+    size_t built = 0;
+    try {
+      for (; built < size; ++built) {
+        construct(p + built, built, alloc_);
+      }
+    } catch (...) {
+      destroyAndDeallocate(p, built, size);
+      throw;
+    }
+  }
+
+  void copyFrom(const Array& other) {
+    T* p = allocate(other.size_);
+    if constexpr (kBulkInit) {
+      std::uninitialized_copy_n(other.data_, other.size_, p);
+    }
+    else {
+      constructFrom(p, other.size_, [&other](T* slot, size_t i, Alloc& a) {
+        Traits::construct(a, slot, other.data_[i]);
+      });
+    }
+    data_ = p;
+    size_ = other.size_;
+  }
+
+  void moveFrom(Array& other) {
+    T* p = allocate(other.size_);
+    constructFrom(p, other.size_, [&other](T* slot, size_t i, Alloc& a) {
+      Traits::construct(a, slot, std::move(other.data_[i]));
+    });
+    data_ = p;
+    size_ = other.size_;
+  }
+
+  void destroyAndDeallocate(T* p, size_t built, size_t capacity) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t i = 0; i < built; ++i) {
+        Traits::destroy(alloc_, p + i);
+      }
+    }
+    if (p != nullptr) {
+      Traits::deallocate(alloc_, p, capacity);
+    }
+  }
+
+  void reset() noexcept {
+    destroyAndDeallocate(data_, size_, size_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  void swapStorage(Array& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+  }
+};
+
+template<typename T> using PmrArray = Array<T, std::pmr::polymorphic_allocator<T>>;
+
+/**
+ * 请求级别的单调分配区
+ * 用法：每个请求在栈上创建一个 RequestArena，从它创建的数组不能活得比它久。
+ * 数组析构时的释放是空操作，RequestArena 析构时一次性归还所有内存。
+ */
+template<size_t InlineBytes = 16 * 1024> class RequestArena {
+  public:
+  explicit RequestArena(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+    : resource_(buffer_, sizeof(buffer_), upstream) {}
+
+  RequestArena(const RequestArena&)                    = delete;
+  auto operator=(const RequestArena&) -> RequestArena& = delete;
+
+  template<typename T> auto makeArray(size_t size) -> PmrArray<T> {
+    return PmrArray<T>(size, &resource_);
+  }
+
+  [[nodiscard]] auto resource() -> std::pmr::memory_resource* { return &resource_; }
+
+  // 提前回收：调用前必须确保从本分配区创建的数组都已销毁
+  void release() { resource_.release(); }
+
+  private:
+  alignas(std::max_align_t) std::byte buffer_[InlineBytes];
+  std::pmr::monotonic_buffer_resource resource_;
+};
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef __ARRAY_EXAMPLE__H
+#define __ARRAY_EXAMPLE__H
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+
+class ArrayExample {
+  public:
+  int*   data;
+  size_t size;
+  size_t capacity;   // 实际分配的元素个数，赋值时 size 不超过它就复用缓冲区
+
+  // 深拷贝累计复制的字节数，基准测试用它计算每次操作拷贝了多少数据
+  inline static size_t copiedBytes = 0;
+
+  ArrayExample(size_t size)
+    : data(new int[size])
+    , size(size)
+    , capacity(size) {}
+
+  ~ArrayExample() { delete[] data; }
+
+  ArrayExample(const ArrayExample& other)
+    : data(new int[other.size])
+    , size(other.size)
+    , capacity(other.size) {
+    init(other);
+  }
+
+  // 移动构造：直接接管缓冲区，不分配也不复制元素
+  // 声明为 noexcept，std::vector 扩容时才会移动而不是拷贝
+  ArrayExample(ArrayExample&& other) noexcept
+    : data(other.data)
+    , size(other.size)
+    , capacity(other.capacity) {
+    other.data     = nullptr;
+    other.size     = 0;
+    other.capacity = 0;
+  }
+
+  // 这里需要复制每一个成员变量
+  auto operator=(const ArrayExample& other) -> ArrayExample& {
+    if (this != &other) {
+      // 容量足够时复用已有缓冲区，省掉一次 delete[] + new[]
+      if (other.size > capacity) {
+        int* fresh = new int[other.size];   // 先分配再释放，分配失败时 *this 保持不变
+        delete[] data;
+        data     = fresh;
+        capacity = other.size;
+      }
+      size = other.size;
+      init(other);
+    }
+    return *this;
+  }
+
+  auto operator=(ArrayExample&& other) noexcept -> ArrayExample& {
+    if (this != &other) {
+      delete[] data;
+      data           = other.data;
+      size           = other.size;
+      capacity       = other.capacity;
+      other.data     = nullptr;
+      other.size     = 0;
+      other.capacity = 0;
+    }
+    return *this;
+  }
+
+  auto init(const ArrayExample& other) -> void {
+    std::copy(other.data, other.data + other.size, data);
+    copiedBytes += other.size * sizeof(int);
+  }
+
+  auto print() const -> void {
+    for (size_t i = 0; i < size; ++i) {
+      std::cout << data[i] << ' ';
+    }
+    std::cout << '\n';
+  }
+};
+
+class DerivedArrayExample : public ArrayExample {
+  public:
+  int extra;
+
+  DerivedArrayExample(size_t size, int extra)
+    : ArrayExample(size)
+    , extra(extra) {}
+
+  // 调用基类的拷贝构造函数，元素只复制一次
+  DerivedArrayExample(const DerivedArrayExample& other)
+    : ArrayExample(other)
+    , extra(other.extra) {}
+
+  DerivedArrayExample(DerivedArrayExample&& other) noexcept
+    : ArrayExample(std::move(other))
+    , extra(other.extra) {}
+
+  // 调用基类的拷贝赋值操作，再复制派生类自己的成员
+  auto operator=(const DerivedArrayExample& other) -> DerivedArrayExample& {
+    if (this != &other) {
+      ArrayExample::operator=(other);
+      extra = other.extra;
+    }
+    return *this;
+  }
+
+  auto operator=(DerivedArrayExample&& other) noexcept -> DerivedArrayExample& {
+    if (this != &other) {
+      ArrayExample::operator=(std::move(other));
+      extra = other.extra;
+    }
+    return *this;
+  }
+};
+
+/**
+ * 小缓冲区优化（SBO）版本：元素个数不超过 InlineCapacity 时存放在对象内部的数组里，
+ * 不做堆分配；超过阈值时退回 new int[size]。
+ * 公有接口与 ArrayExample 相同，data 总是指向当前使用的存储。
+ */
+template<size_t InlineCapacity = 16> class SmallArrayExample {
+  static_assert(InlineCapacity > 0, "use ArrayExample when no inline storage is wanted");
+
+  public:
+  int*   data;
+  size_t size;
+  size_t capacity;   // 内联存储时等于 InlineCapacity
+
+  inline static size_t copiedBytes = 0;
+
+  SmallArrayExample(size_t size)
+    : data(size <= InlineCapacity ? inline_ : new int[size])
+    , size(size)
+    , capacity(std::max(size, InlineCapacity)) {}
+
+  ~SmallArrayExample() { freeHeap(); }
+
+  SmallArrayExample(const SmallArrayExample& other)
+    : SmallArrayExample(other.size) {
+    init(other);
+  }
+
+  // 堆上的缓冲区直接接管；内联的元素只能逐个复制（最多 InlineCapacity 个）
+  SmallArrayExample(SmallArrayExample&& other) noexcept
+    : data(inline_)
+    , size(other.size)
+    , capacity(InlineCapacity) {
+    if (other.isInline()) {
+      std::copy(other.data, other.data + other.size, inline_);
+    }
+    else {
+      data     = other.data;
+      capacity = other.capacity;
+    }
+    other.reset();
+  }
+
+  auto operator=(const SmallArrayExample& other) -> SmallArrayExample& {
+    if (this != &other) {
+      // 当前存储（内联或堆）放得下就复用
+      if (other.size > capacity) {
+        int* fresh = new int[other.size];
+        freeHeap();
+        data     = fresh;
+        capacity = other.size;
+      }
+      size = other.size;
+      init(other);
+    }
+    return *this;
+  }
+
+  auto operator=(SmallArrayExample&& other) noexcept -> SmallArrayExample& {
+    if (this != &other) {
+      if (other.isInline()) {
+        // other.size <= InlineCapacity <= capacity，当前存储一定放得下
+        std::copy(other.data, other.data + other.size, data);
+        size = other.size;
+      }
+      else {
+        freeHeap();
+        data     = other.data;
+        size     = other.size;
+        capacity = other.capacity;
+      }
+      other.reset();
+    }
+    return *this;
+  }
+
+  auto init(const SmallArrayExample& other) -> void {
+    std::copy(other.data, other.data + other.size, data);
+    copiedBytes += other.size * sizeof(int);
+  }
+
+  [[nodiscard]] auto isInline() const -> bool { return data == inline_; }
+
+  auto print() const -> void {
+    for (size_t i = 0; i < size; ++i) {
+      std::cout << data[i] << ' ';
+    }
+    std::cout << '\n';
+  }
+
+  private:
+  int inline_[InlineCapacity];
+
+  auto freeHeap() -> void {
+    if (!isInline()) {
+      delete[] data;
+    }
+  }
+
+  // 被移动后回到空的内联状态，仍然可以安全地赋值和析构
+  auto reset() -> void {
+    data     = inline_;
+    size     = 0;
+    capacity = InlineCapacity;
+  }
+};
+
+#endif
@@ -0,0 +1,375 @@
+#ifndef __BULK_OPS__H
+#define __BULK_OPS__H
+
+/**
+ * @file bulk_ops.h
+ * @brief 64 字节对齐的数组存储与向量化的批量 copy / fill / equal / find
+ *
+ * - AlignedAllocator<T, 64> 让 Array<T, Alloc> 的缓冲区按缓存行对齐，AlignedArray<T> 是它的别名
+ * - bulk:: 下的函数在运行时检测 CPU，依次选择 AVX-512、AVX2 或标量实现（GCC/Clang + x86-64），
+ *   不需要用 -march 编译整个程序
+ * - 目标区间超过末级缓存（LLC）大小时，copy / fill 改用非临时存储（streaming store），
+ *   数据直接写回内存而不污染缓存，大数组拷贝可以接近 DRAM 带宽
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "allocator_array.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#  define BULK_OPS_X86 1
+#  include <immintrin.h>
+#endif
+
+template<typename T, size_t Alignment = 64> class AlignedAllocator {
+  static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+
+  public:
+  using value_type      = T;
+  using is_always_equal = std::true_type;
+
+  template<typename U> struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() noexcept = default;
+  template<typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+  auto allocate(size_t n) -> T* {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T* p, size_t) noexcept { ::operator delete(p, std::align_val_t(Alignment)); }
+
+  template<typename U> auto operator==(const AlignedAllocator<U, Alignment>&) const -> bool {
+    return true;
+  }
+  template<typename U> auto operator!=(const AlignedAllocator<U, Alignment>&) const -> bool {
+    return false;
+  }
+};
+
+template<typename U, size_t Alignment>
+struct HasPlainConstruct<AlignedAllocator<U, Alignment>> : std::true_type {};
+
+template<typename T> using AlignedArray = Array<T, AlignedAllocator<T, 64>>;
+
+namespace bulk {
+
+enum class Isa
+{
+  Scalar,
+  Avx2,
+  Avx512
+};
+
+inline auto detectIsa() -> Isa {
+#if defined(BULK_OPS_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return Isa::Avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return Isa::Avx2;
+  }
+#endif
+  return Isa::Scalar;
+}
+
+// 当前使用的指令集，基准测试可以改写它来对比不同实现（不能超出 CPU 实际支持的范围）
+inline auto activeIsa() -> Isa& {
+  static Isa isa = detectIsa();
+  return isa;
+}
+
+// 超过这个字节数的 copy / fill 使用非临时存储，默认取 LLC 大小
+inline auto nonTemporalThreshold() -> size_t& {
+  static size_t threshold = [] {
+    const long llc = ::sysconf(_SC_LEVEL3_CACHE_SIZE);
+    return llc > 0 ? static_cast<size_t>(llc) : size_t{32} << 20;
+  }();
+  return threshold;
+}
+
+namespace detail {
+
+inline auto alignedTo(const void* p, size_t alignment) -> bool {
+  return (reinterpret_cast<uintptr_t>(p) & (alignment - 1)) == 0;
+}
+
+#if defined(BULK_OPS_X86)
+
+// 只负责流式路径；缓存内的拷贝交给 memcpy（glibc 已按 CPU 选择了最优实现）
+__attribute__((target("avx2"))) inline void streamCopyAvx2(int* dst, const int* src, size_t n) {
+  size_t i = 0;
+  // 流式存储要求目标 32 字节对齐，先用标量补齐开头
+  for (; i < n && !alignedTo(dst + i, 32); ++i) {
+    dst[i] = src[i];
+  }
+  const size_t end = i + (n - i) / 32 * 32;
+  for (; i < end; i += 32) {
+    const auto*   s  = reinterpret_cast<const __m256i*>(src + i);
+    auto*         d  = reinterpret_cast<__m256i*>(dst + i);
+    const __m256i v0 = _mm256_loadu_si256(s);
+    const __m256i v1 = _mm256_loadu_si256(s + 1);
+    const __m256i v2 = _mm256_loadu_si256(s + 2);
+    const __m256i v3 = _mm256_loadu_si256(s + 3);
+    _mm256_stream_si256(d, v0);
+    _mm256_stream_si256(d + 1, v1);
+    _mm256_stream_si256(d + 2, v2);
+    _mm256_stream_si256(d + 3, v3);
+  }
+  _mm_sfence();
+  for (; i < n; ++i) {
+    dst[i] = src[i];
+  }
+}
+
+__attribute__((target("avx512f"))) inline void streamCopyAvx512(
+  int* dst, const int* src, size_t n) {
+  size_t i = 0;
+  for (; i < n && !alignedTo(dst + i, 64); ++i) {
+    dst[i] = src[i];
+  }
+  const size_t end = i + (n - i) / 64 * 64;
+  for (; i < end; i += 64) {
+    const __m512i v0 = _mm512_loadu_si512(src + i);
+    const __m512i v1 = _mm512_loadu_si512(src + i + 16);
+    const __m512i v2 = _mm512_loadu_si512(src + i + 32);
+    const __m512i v3 = _mm512_loadu_si512(src + i + 48);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i), v0);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i + 16), v1);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i + 32), v2);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i + 48), v3);
+  }
+  _mm_sfence();
+  for (; i < n; ++i) {
+    dst[i] = src[i];
+  }
+}
+
+__attribute__((target("avx2"))) inline void fillAvx2(
+  int* dst, int value, size_t n, bool streaming) {
+  const __m256i v = _mm256_set1_epi32(value);
+  size_t        i = 0;
+  for (; i < n && !alignedTo(dst + i, 32); ++i) {
+    dst[i] = value;
+  }
+  const size_t end = i + (n - i) / 8 * 8;
+  if (streaming) {
+    for (; i < end; i += 8) {
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), v);
+    }
+    _mm_sfence();
+  }
+  else {
+    for (; i < end; i += 8) {
+      _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), v);
+    }
+  }
+  for (; i < n; ++i) {
+    dst[i] = value;
+  }
+}
+
+__attribute__((target("avx512f"))) inline void fillAvx512(
+  int* dst, int value, size_t n, bool streaming) {
+  const __m512i v = _mm512_set1_epi32(value);
+  size_t        i = 0;
+  for (; i < n && !alignedTo(dst + i, 64); ++i) {
+    dst[i] = value;
+  }
+  const size_t end = i + (n - i) / 16 * 16;
+  if (streaming) {
+    for (; i < end; i += 16) {
+      _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i), v);
+    }
+    _mm_sfence();
+  }
+  else {
+    for (; i < end; i += 16) {
+      _mm512_store_si512(dst + i, v);
+    }
+  }
+  for (; i < n; ++i) {
+    dst[i] = value;
+  }
+}
+
+__attribute__((target("avx2"))) inline auto equalAvx2(const int* a, const int* b, size_t n)
+  -> bool {
+  size_t       i   = 0;
+  const size_t end = n / 8 * 8;
+  for (; i < end; i += 8) {
+    const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(va, vb)) != -1) {
+      return false;
+    }
+  }
+  for (; i < n; ++i) {
+    if (a[i] != b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+__attribute__((target("avx512f"))) inline auto equalAvx512(const int* a, const int* b, size_t n)
+  -> bool {
+  size_t       i   = 0;
+  const size_t end = n / 16 * 16;
+  for (; i < end; i += 16) {
+    if (_mm512_cmpneq_epi32_mask(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i)) != 0) {
+      return false;
+    }
+  }
+  for (; i < n; ++i) {
+    if (a[i] != b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+__attribute__((target("avx2"))) inline auto findAvx2(const int* p, size_t n, int value)
+  -> size_t {
+  const __m256i v   = _mm256_set1_epi32(value);
+  size_t        i   = 0;
+  const size_t  end = n / 8 * 8;
+  for (; i < end; i += 8) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(chunk, v)));
+    if (mask != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+    }
+  }
+  for (; i < n; ++i) {
+    if (p[i] == value) {
+      return i;
+    }
+  }
+  return n;
+}
+
+__attribute__((target("avx512f"))) inline auto findAvx512(const int* p, size_t n, int value)
+  -> size_t {
+  const __m512i v   = _mm512_set1_epi32(value);
+  size_t        i   = 0;
+  const size_t  end = n / 16 * 16;
+  for (; i < end; i += 16) {
+    const __mmask16 mask = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(p + i), v);
+    if (mask != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+    }
+  }
+  for (; i < n; ++i) {
+    if (p[i] == value) {
+      return i;
+    }
+  }
+  return n;
+}
+
+#endif
+
+inline auto useStreaming(size_t n) -> bool {
+  return n * sizeof(int) >= nonTemporalThreshold();
+}
+
+}   // namespace detail
+
+// dst 与 src 不能重叠
+inline void copy(int* dst, const int* src, size_t n) {
+#if defined(BULK_OPS_X86)
+  if (detail::useStreaming(n)) {
+    switch (activeIsa()) {
+    case Isa::Avx512:
+      return detail::streamCopyAvx512(dst, src, n);
+    case Isa::Avx2:
+      return detail::streamCopyAvx2(dst, src, n);
+    case Isa::Scalar:
+      break;
+    }
+  }
+#endif
+  if (n > 0) {
+    std::memcpy(dst, src, n * sizeof(int));
+  }
+}
+
+inline void fill(int* dst, int value, size_t n) {
+#if defined(BULK_OPS_X86)
+  switch (activeIsa()) {
+  case Isa::Avx512:
+    return detail::fillAvx512(dst, value, n, detail::useStreaming(n));
+  case Isa::Avx2:
+    return detail::fillAvx2(dst, value, n, detail::useStreaming(n));
+  case Isa::Scalar:
+    break;
+  }
+#endif
+  std::fill_n(dst, n, value);
+}
+
+inline auto equal(const int* a, const int* b, size_t n) -> bool {
+#if defined(BULK_OPS_X86)
+  switch (activeIsa()) {
+  case Isa::Avx512:
+    return detail::equalAvx512(a, b, n);
+  case Isa::Avx2:
+    return detail::equalAvx2(a, b, n);
+  case Isa::Scalar:
+    break;
+  }
+#endif
+  return n == 0 || std::memcmp(a, b, n * sizeof(int)) == 0;
+}
+
+// 返回第一个等于 value 的下标，找不到时返回 n
+inline auto find(const int* p, size_t n, int value) -> size_t {
+#if defined(BULK_OPS_X86)
+  switch (activeIsa()) {
+  case Isa::Avx512:
+    return detail::findAvx512(p, n, value);
+  case Isa::Avx2:
+    return detail::findAvx2(p, n, value);
+  case Isa::Scalar:
+    break;
+  }
+#endif
+  for (size_t i = 0; i < n; ++i) {
+    if (p[i] == value) {
+      return i;
+    }
+  }
+  return n;
+}
+
+// Array 版本：拷贝时两者大小必须相同
+template<typename Alloc> void copy(Array<int, Alloc>& dst, const Array<int, Alloc>& src) {
+  copy(dst.data(), src.data(), src.size());
+}
+
+template<typename Alloc> void fill(Array<int, Alloc>& dst, int value) {
+  fill(dst.data(), value, dst.size());
+}
+
+template<typename Alloc>
+auto equal(const Array<int, Alloc>& a, const Array<int, Alloc>& b) -> bool {
+  return a.size() == b.size() && equal(a.data(), b.data(), a.size());
+}
+
+template<typename Alloc> auto find(const Array<int, Alloc>& array, int value) -> size_t {
+  return find(array.data(), array.size(), value);
+}
+
+}   // namespace bulk
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef __HUGE_ARRAY__H
+#define __HUGE_ARRAY__H
+
+/**
+ * @file huge_array.h
+ * @brief 基于 mmap 的超大数组（仅限 Linux）
+ *
+ * new int[size] 会在构造时提交并清零全部内存，几亿个元素的数组构造和拷贝都要把每一页碰两遍。
+ * HugeArrayExample 改为：
+ * - 匿名 mmap + MAP_NORESERVE：构造是 O(1)，页面在第一次访问时才由内核分配（读到的是 0）
+ * - 可选 MADV_HUGEPAGE，让内核尽量用透明大页减少 TLB miss
+ * - 移动只交换指针；resize 用 mremap 搬移页表，不复制数据
+ * - 拷贝只复制源数组真正提交过的页（通过 /proc/self/pagemap 判断），
+ *   没碰过的页在副本里仍然是懒分配的零页；pagemap 不可读或源数组是文件映射时退化为整体复制
+ *   （用户态无法对私有匿名内存做页级写时复制，fork 之外没有这样的系统调用）
+ * - mapFile 把数组映射到文件（MAP_SHARED），sync() 后数据持久化，下次 mapFile 同一文件即可恢复；
+ *   mapFile 只会扩展文件，文件比 size 长时多出的部分保留在文件里，只有 resize() 会截断文件
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <utility>
+
+class HugeArrayExample {
+  public:
+  int*   data = nullptr;
+  size_t size = 0;
+
+  HugeArrayExample() = default;
+
+  explicit HugeArrayExample(size_t size, bool hugePages = false)
+    : size(size)
+    , hugePages_(hugePages) {
+    mapAnonymous(mappedBytesFor(size));
+  }
+
+  // 映射（必要时创建并扩展）文件，文件原有内容即数组内容，超出文件长度的部分为 0
+  static auto mapFile(const std::string& path, size_t size) -> HugeArrayExample {
+    HugeArrayExample array;
+    array.fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (array.fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    array.size = size;
+    array.growFile(size * sizeof(int));
+    array.mapShared(mappedBytesFor(size));
+    return array;
+  }
+
+  ~HugeArrayExample() { unmap(); }
+
+  // 拷贝总是得到匿名内存，只复制源数组已提交的页
+  HugeArrayExample(const HugeArrayExample& other)
+    : size(other.size)
+    , hugePages_(other.hugePages_) {
+    mapAnonymous(mappedBytesFor(size));
+    if (other.isFileBacked()) {
+      // 文件映射中没有出现在页表里的页仍然可能有数据（在文件里），只能整体复制
+      std::memcpy(data, other.data, size * sizeof(int));
+    }
+    else {
+      copyCommittedPages(other.data, data, size * sizeof(int));
+    }
+  }
+
+  HugeArrayExample(HugeArrayExample&& other) noexcept { swap(other); }
+
+  auto operator=(const HugeArrayExample& other) -> HugeArrayExample& {
+    if (this != &other) {
+      HugeArrayExample copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  auto operator=(HugeArrayExample&& other) noexcept -> HugeArrayExample& {
+    if (this != &other) {
+      HugeArrayExample moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  void swap(HugeArrayExample& other) noexcept {
+    std::swap(data, other.data);
+    std::swap(size, other.size);
+    std::swap(mappedBytes_, other.mappedBytes_);
+    std::swap(fd_, other.fd_);
+    std::swap(hugePages_, other.hugePages_);
+  }
+
+  // mremap 只搬移页表，不复制数据；新增部分读出来是 0。
+  // 文件映射的文件长度随之改变：缩小时截断文件，多出的数据被丢弃
+  void resize(size_t newSize) {
+    const size_t newBytes = mappedBytesFor(newSize);
+    if (fd_ >= 0) {
+      resizeFile(newSize * sizeof(int));
+    }
+    if (mappedBytes_ == 0) {
+      if (fd_ >= 0) {
+        mapShared(newBytes);
+      }
+      else {
+        mapAnonymous(newBytes);
+      }
+    }
+    else if (newBytes == 0) {
+      unmapRegion();
+    }
+    else if (newBytes != mappedBytes_) {
+      void* moved = ::mremap(data, mappedBytes_, newBytes, MREMAP_MAYMOVE);
+      if (moved == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "mremap");
+      }
+      // 匿名映射缩小后再扩大时，内核会给新增的页补零，不会露出旧数据
+      data         = static_cast<int*>(moved);
+      mappedBytes_ = newBytes;
+      adviseHugePages();
+    }
+    size = newSize;
+  }
+
+  // 文件映射：把脏页写回磁盘；匿名映射：什么也不做
+  void sync() const {
+    if (fd_ >= 0 && mappedBytes_ > 0 && ::msync(data, mappedBytes_, MS_SYNC) != 0) {
+      throw std::system_error(errno, std::generic_category(), "msync");
+    }
+  }
+
+  [[nodiscard]] auto isFileBacked() const -> bool { return fd_ >= 0; }
+  [[nodiscard]] auto mappedBytes() const -> size_t { return mappedBytes_; }
+
+  // 实际驻留在内存中的字节数（mincore），用来观察懒提交
+  [[nodiscard]] auto residentBytes() const -> size_t {
+    if (mappedBytes_ == 0) {
+      return 0;
+    }
+    const size_t page  = pageSize();
+    const size_t pages = mappedBytes_ / page;
+    size_t       resident = 0;
+    unsigned char vec[4096];
+    for (size_t first = 0; first < pages; first += sizeof(vec)) {
+      const size_t count = std::min(sizeof(vec), pages - first);
+      if (::mincore(reinterpret_cast<char*>(data) + first * page, count * page, vec) != 0) {
+        throw std::system_error(errno, std::generic_category(), "mincore");
+      }
+      for (size_t i = 0; i < count; ++i) {
+        resident += vec[i] & 1u;
+      }
+    }
+    return resident * page;
+  }
+
+  private:
+  size_t mappedBytes_ = 0;
+  int    fd_          = -1;
+  bool   hugePages_   = false;
+
+  static auto pageSize() -> size_t {
+    static const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return page;
+  }
+
+  static auto mappedBytesFor(size_t elements) -> size_t {
+    const size_t page = pageSize();
+    return (elements * sizeof(int) + page - 1) / page * page;
+  }
+
+  void mapAnonymous(size_t bytes) {
+    if (bytes == 0) {
+      return;
+    }
+    void* p = ::mmap(
+      nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+      throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    data         = static_cast<int*>(p);
+    mappedBytes_ = bytes;
+    adviseHugePages();
+  }
+
+  void mapShared(size_t bytes) {
+    if (bytes == 0) {
+      return;
+    }
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+      throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    data         = static_cast<int*>(p);
+    mappedBytes_ = bytes;
+  }
+
+  // 文件比 bytes 短时扩展，否则保持原样（不截断已有数据）
+  void growFile(size_t bytes) const {
+    struct stat st {};
+    if (::fstat(fd_, &st) != 0) {
+      throw std::system_error(errno, std::generic_category(), "fstat");
+    }
+    if (static_cast<size_t>(st.st_size) < bytes) {
+      resizeFile(bytes);
+    }
+  }
+
+  // ftruncate 扩展出的是稀疏文件，不占磁盘也不写数据
+  void resizeFile(size_t bytes) const {
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+      throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+  }
+
+  // 透明大页只对匿名映射有意义，失败（内核不支持）时忽略
+  void adviseHugePages() const {
+    if (hugePages_ && fd_ < 0 && mappedBytes_ > 0) {
+      ::madvise(data, mappedBytes_, MADV_HUGEPAGE);
+    }
+  }
+
+  void unmapRegion() noexcept {
+    if (mappedBytes_ > 0) {
+      ::munmap(data, mappedBytes_);
+    }
+    data         = nullptr;
+    mappedBytes_ = 0;
+  }
+
+  void unmap() noexcept {
+    unmapRegion();
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  // 按 /proc/self/pagemap 找出源区间中已提交（在内存或交换区）的页，只复制这些页
+  static void copyCommittedPages(const int* src, int* dst, size_t bytes) {
+    if (bytes == 0) {
+      return;
+    }
+    const int pagemap = ::open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    if (pagemap < 0) {
+      std::memcpy(dst, src, bytes);
+      return;
+    }
+
+    constexpr uint64_t kPresent = 1ULL << 63;
+    constexpr uint64_t kSwapped = 1ULL << 62;
+    constexpr size_t   kBatch   = 4096;
+
+    const size_t page      = pageSize();
+    const size_t pages     = (bytes + page - 1) / page;
+    const auto   firstPage = reinterpret_cast<uintptr_t>(src) / page;
+    uint64_t     entries[kBatch];
+
+    for (size_t batch = 0; batch < pages; batch += kBatch) {
+      const size_t  count  = std::min(kBatch, pages - batch);
+      const auto    offset = static_cast<off_t>((firstPage + batch) * sizeof(uint64_t));
+      const ssize_t got    = ::pread(pagemap, entries, count * sizeof(uint64_t), offset);
+      if (got != static_cast<ssize_t>(count * sizeof(uint64_t))) {
+        // 读取失败时剩余部分整体复制
+        const size_t done = batch * page;
+        std::memcpy(
+          reinterpret_cast<char*>(dst) + done, reinterpret_cast<const char*>(src) + done, bytes - done);
+        break;
+      }
+      // 连续的已提交页合并成一次 memcpy
+      size_t i = 0;
+      while (i < count) {
+        if ((entries[i] & (kPresent | kSwapped)) == 0) {
+          ++i;
+          continue;
+        }
+        size_t run = i;
+        while (run < count && (entries[run] & (kPresent | kSwapped)) != 0) {
+          ++run;
+        }
+        const size_t begin = (batch + i) * page;
+        const size_t end   = std::min((batch + run) * page, bytes);
+        std::memcpy(
+          reinterpret_cast<char*>(dst) + begin,
+          reinterpret_cast<const char*>(src) + begin,
+          end - begin);
+        i = run;
+      }
+    }
+    ::close(pagemap);
+  }
+};
+
+#endif
@@ -1,4 +1,8 @@
 #include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "vector3_storage.h"
 
 template<typename T> class Vector3 {
   public:
@@ -35,6 +39,7 @@ template<typename T> class Vector3 {
 };
 
 typedef Vector3<int> Vector3i;
+typedef Vector3<float> Vector3f;
 
 auto main() -> int {
   Vector3i v1(1, 2, 3);
@@ -47,5 +52,22 @@ auto main() -> int {
   v3 = v1 + v2 + v3;
   v3.print();
 
+  // 压缩存储：解码迭代器按值返回 Vector3f，已有的算法可以直接遍历
+  std::vector<Vector3f> points = {{1.5f, -2.25f, 3.0f}, {0.1f, 0.2f, 0.3f}, {-8.0f, 4.5f, 100.0f}};
+  vector3_storage::HalfVector3Array<Vector3f> halfPoints(points.begin(), points.end());
+  auto quantized =
+    vector3_storage::QuantizedVector3Array<Vector3f>::fromRange(points.begin(), points.end());
+
+  std::accumulate(halfPoints.begin(), halfPoints.end(), Vector3f()).print();
+  std::accumulate(quantized.begin(), quantized.end(), Vector3f()).print();
+  std::cout << points.size() * sizeof(Vector3f) << " bytes -> " << halfPoints.bytes() << " bytes"
+            << std::endl;
+
+  std::vector<Vector3f> normals = {{0.0f, 0.0f, 1.0f}, {0.6f, 0.0f, -0.8f}};
+  vector3_storage::OctahedralNormalArray<Vector3f> packedNormals(normals.begin(), normals.end());
+  for (const auto& n : packedNormals) {
+    n.print();
+  }
+
   return 0;
 }
\ No newline at end of file
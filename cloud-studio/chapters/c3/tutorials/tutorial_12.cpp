@@ -1,79 +1,9 @@
 
-#include <algorithm>
 #include <iostream>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
-class ArrayExample {
-  public:
-  int*   data;
-  size_t size;
-
-  ArrayExample(size_t size)
-    : data(new int[size])
-    , size(size) {}
-
-  ~ArrayExample() { delete[] data; }
-
-  ArrayExample(const ArrayExample& other)
-    : data(new int[other.size])
-    , size(other.size) {
-    init(other);
-  }
-
-  // 这里需要复制每一个成员变量
-  auto operator=(const ArrayExample& other) -> ArrayExample& {
-    if (this != &other) {
-      delete[] data;
-      data = new int[other.size];
-      size = other.size;
-      init(other);
-    }
-    return *this;
-  }
-
-  auto init(const ArrayExample& other) -> void {
-    std::copy(other.data, other.data + other.size, data);
-  }
-
-  auto print() const -> void {
-    for (size_t i = 0; i < size; ++i) {
-      std::cout << data[i] << ' ';
-    }
-    std::cout << '\n';
-  }
-};
-
-class DerivedArrayExample : public ArrayExample {
-  public:
-  int extra;
-
-  DerivedArrayExample(size_t size, int extra)
-    : ArrayExample(size)
-    , extra(extra) {}
-
-  DerivedArrayExample(const DerivedArrayExample& other)
-    : ArrayExample(other.size)
-    , extra(other.extra) {
-    init(other);
-  }
-
-  // 调用基类的拷贝赋值操作
-  auto operator=(const DerivedArrayExample& other) -> DerivedArrayExample& {
-    if (this != &other) {
-      ArrayExample::operator=(other);
-      extra = other.extra;
-      init(other);
-    }
-    return *this;
-  }
-
-  auto init(const DerivedArrayExample& other) -> void {
-    std::copy(other.data, other.data + other.size, data);
-    extra = other.extra;
-  }
-};
-
+#include "array_example.h"
 
 auto main() -> int {
   DerivedArrayExample c(10, 1);
@@ -84,5 +14,23 @@ auto main() -> int {
   d = c;
   d.print();
 
+  // 移动：接管缓冲区，不复制元素
+  DerivedArrayExample e(std::move(d));
+  e.print();
+
+  // noexcept 移动构造让 vector 扩容时移动元素而不是深拷贝
+  std::vector<ArrayExample> arrays;
+  for (size_t i = 0; i < 8; ++i) {
+    arrays.emplace_back(1000);
+  }
+  std::cout << "bytes copied: " << ArrayExample::copiedBytes << '\n';
+
+  // 小缓冲区优化：不超过 16 个元素时不做堆分配
+  SmallArrayExample<16> small(8);
+  SmallArrayExample<16> large(100);
+  std::cout << "small inline: " << small.isInline() << ", large inline: " << large.isInline()
+            << '\n';
+  large = small;   // 复用 large 已有的堆缓冲区
+
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,464 @@
+#ifndef __VECTOR3_STORAGE__H
+#define __VECTOR3_STORAGE__H
+
+/**
+ * @file vector3_storage.h
+ * @brief Vector3 的压缩存储格式
+ *
+ * 本文件提供三种压缩格式（均为 header-only，对 V 只要求有 x/y/z 成员和 V(x, y, z) 构造）：
+ * 1. HalfVector3Array：16 位半精度浮点，6 字节/点
+ * 2. QuantizedVector3Array：相对包围盒的 16 位定点量化，6 字节/点
+ * 3. OctahedralNormalArray：八面体编码的单位法线，4 字节/点
+ *
+ * 编解码核心是对连续 float 数组的批量函数，
+ * 开启 F16C（-mf16c 或 -march=native）时半精度转换走 SIMD 指令，其余循环写成可自动向量化的形式。
+ * 每种数组都提供解码迭代器，已有的 Vector3 算法（std::accumulate 等）可以直接遍历。
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#if defined(__F16C__)
+#  include <immintrin.h>
+#endif
+
+namespace vector3_storage {
+
+// 编码时每次收集多少个点再调用批量核函数
+constexpr size_t kBlockPoints = 256;
+
+// ---------------------------------------------------------------------------
+// 半精度浮点
+// ---------------------------------------------------------------------------
+
+// 标量版本：就近舍入（ties-to-even），与 F16C 指令的结果一致
+inline auto floatToHalf(float value) -> uint16_t {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const auto     sign    = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+  const uint32_t absBits = bits & 0x7fffffffu;
+
+  if (absBits >= 0x7f800000u) {   // inf / NaN
+    return sign | 0x7c00u | (absBits > 0x7f800000u ? 0x0200u : 0u);
+  }
+  if (absBits >= 0x47800000u) {   // >= 65536，必然溢出为 inf
+    return sign | 0x7c00u;
+  }
+  if (absBits < 0x38800000u) {   // 小于 2^-14：结果为半精度非规格化数或 0
+    if (absBits < 0x33000000u) {
+      return sign;
+    }
+    const uint32_t exponent = absBits >> 23;
+    const uint32_t mantissa = (absBits & 0x7fffffu) | 0x800000u;
+    const uint32_t shift    = 126 - exponent;
+    uint32_t       half     = mantissa >> shift;
+    const uint32_t rest     = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway  = 1u << (shift - 1);
+    if (rest > halfway || (rest == halfway && (half & 1u))) {
+      ++half;
+    }
+    return static_cast<uint16_t>(sign | half);
+  }
+
+  // 规格化数：指数偏置从 127 调整为 15，尾数截掉 13 位后舍入（进位可能进入指数，得到 inf 也是正确的）
+  uint32_t       half = (absBits - 0x38000000u) >> 13;
+  const uint32_t rest = absBits & 0x1fffu;
+  if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) {
+    ++half;
+  }
+  return static_cast<uint16_t>(sign | half);
+}
+
+inline auto halfToFloat(uint16_t half) -> float {
+  const uint32_t sign     = static_cast<uint32_t>(half & 0x8000u) << 16;
+  const uint32_t exponent = (half >> 10) & 0x1fu;
+  const uint32_t mantissa = half & 0x3ffu;
+
+  uint32_t bits;
+  if (exponent == 0) {
+    // 0 或非规格化数：mantissa * 2^-24，在 float 中可以精确表示
+    const float magnitude = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+    std::memcpy(&bits, &magnitude, sizeof(bits));
+    bits |= sign;
+  }
+  else if (exponent == 31) {
+    bits = sign | 0x7f800000u | (mantissa << 13);
+  }
+  else {
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  }
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// 批量编码：src 与 dst 各含 count 个标量
+inline void encodeHalf(const float* src, uint16_t* dst, size_t count) {
+  size_t i = 0;
+#if defined(__F16C__)
+  const size_t simdEnd = count - count % 8;
+  for (; i < simdEnd; i += 8) {
+    const __m256  v = _mm256_loadu_ps(src + i);
+    const __m128i h = _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = floatToHalf(src[i]);
+  }
+}
+
+inline void decodeHalf(const uint16_t* src, float* dst, size_t count) {
+  size_t i = 0;
+#if defined(__F16C__)
+  const size_t simdEnd = count - count % 8;
+  for (; i < simdEnd; i += 8) {
+    const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = halfToFloat(src[i]);
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 包围盒定点量化
+// ---------------------------------------------------------------------------
+
+struct Bounds {
+  float min[3] = {0.0f, 0.0f, 0.0f};
+  float max[3] = {0.0f, 0.0f, 0.0f};
+};
+
+// 每个分量 16 位，量化步长为 (max - min) / 65535
+class Quantizer {
+  public:
+  Quantizer() = default;
+
+  explicit Quantizer(const Bounds& bounds)
+    : bounds_(bounds) {
+    for (int axis = 0; axis < 3; ++axis) {
+      const float extent = bounds.max[axis] - bounds.min[axis];
+      // 包围盒在某一轴上退化为平面时，该轴全部量化为 0
+      scale_[axis]    = extent > 0.0f ? 65535.0f / extent : 0.0f;
+      invScale_[axis] = extent > 0.0f ? extent / 65535.0f : 0.0f;
+    }
+  }
+
+  [[nodiscard]] auto bounds() const -> const Bounds& { return bounds_; }
+
+  // 批量编码：src/dst 为交错排列的 xyz，共 points 个点
+  void encode(const float* src, uint16_t* dst, size_t points) const {
+    for (int axis = 0; axis < 3; ++axis) {
+      const float lo    = bounds_.min[axis];
+      const float scale = scale_[axis];
+      for (size_t i = 0; i < points; ++i) {
+        float q = (src[i * 3 + axis] - lo) * scale + 0.5f;
+        q       = std::min(std::max(q, 0.0f), 65535.0f);
+        dst[i * 3 + axis] = static_cast<uint16_t>(q);
+      }
+    }
+  }
+
+  void decode(const uint16_t* src, float* dst, size_t points) const {
+    for (int axis = 0; axis < 3; ++axis) {
+      const float lo       = bounds_.min[axis];
+      const float invScale = invScale_[axis];
+      for (size_t i = 0; i < points; ++i) {
+        dst[i * 3 + axis] = lo + static_cast<float>(src[i * 3 + axis]) * invScale;
+      }
+    }
+  }
+
+  private:
+  Bounds bounds_;
+  float  scale_[3]    = {0.0f, 0.0f, 0.0f};
+  float  invScale_[3] = {0.0f, 0.0f, 0.0f};
+};
+
+// ---------------------------------------------------------------------------
+// 八面体法线编码
+// ---------------------------------------------------------------------------
+
+// 单位向量投影到八面体再展开到 [-1, 1]^2，两个分量各用 16 位 snorm 存储
+inline void encodeOctahedral(const float* src, int16_t* dst, size_t points) {
+  for (size_t i = 0; i < points; ++i) {
+    const float x  = src[i * 3];
+    const float y  = src[i * 3 + 1];
+    const float z  = src[i * 3 + 2];
+    const float l1 = std::fabs(x) + std::fabs(y) + std::fabs(z);
+    // 零向量编码为 (0, 0)，解码后得到 (0, 0, 1)
+    const float inv = l1 > 0.0f ? 1.0f / l1 : 0.0f;
+    float       px  = x * inv;
+    float       py  = y * inv;
+    // 下半球沿对角线折叠到外侧三角形
+    const float fx = (1.0f - std::fabs(py)) * std::copysign(1.0f, px);
+    const float fy = (1.0f - std::fabs(px)) * std::copysign(1.0f, py);
+    px             = z < 0.0f ? fx : px;
+    py             = z < 0.0f ? fy : py;
+    px             = std::min(std::max(px, -1.0f), 1.0f);
+    py             = std::min(std::max(py, -1.0f), 1.0f);
+
+    dst[i * 2]     = static_cast<int16_t>(std::lround(px * 32767.0f));
+    dst[i * 2 + 1] = static_cast<int16_t>(std::lround(py * 32767.0f));
+  }
+}
+
+inline void decodeOctahedral(const int16_t* src, float* dst, size_t points) {
+  for (size_t i = 0; i < points; ++i) {
+    float       x = std::max(static_cast<float>(src[i * 2]) * (1.0f / 32767.0f), -1.0f);
+    float       y = std::max(static_cast<float>(src[i * 2 + 1]) * (1.0f / 32767.0f), -1.0f);
+    const float z = 1.0f - std::fabs(x) - std::fabs(y);
+    const float t = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+    const float inv = 1.0f / std::sqrt(x * x + y * y + z * z);
+    dst[i * 3]      = x * inv;
+    dst[i * 3 + 1]  = y * inv;
+    dst[i * 3 + 2]  = z * inv;
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 解码迭代器：按值返回 V，使已有的 Vector3 算法可以流式遍历压缩数组
+// ---------------------------------------------------------------------------
+
+template<typename Array> class DecodingIterator {
+  public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type        = typename Array::value_type;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = void;
+  using reference         = value_type;
+
+  DecodingIterator() = default;
+  DecodingIterator(const Array* array, size_t index)
+    : array_(array)
+    , index_(index) {}
+
+  auto operator*() const -> value_type { return (*array_)[index_]; }
+
+  auto operator++() -> DecodingIterator& {
+    ++index_;
+    return *this;
+  }
+
+  auto operator++(int) -> DecodingIterator {
+    DecodingIterator old = *this;
+    ++index_;
+    return old;
+  }
+
+  auto operator-(const DecodingIterator& other) const -> difference_type {
+    return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+  }
+
+  auto operator==(const DecodingIterator& other) const -> bool {
+    return array_ == other.array_ && index_ == other.index_;
+  }
+  auto operator!=(const DecodingIterator& other) const -> bool { return !(*this == other); }
+
+  private:
+  const Array* array_ = nullptr;
+  size_t       index_ = 0;
+};
+
+namespace detail {
+
+// 按块把任意 V 序列收集成交错 float，再交给批量核函数
+template<typename It, typename Encode> void encodeBlocks(It first, It last, Encode encode) {
+  float  block[kBlockPoints * 3];
+  size_t filled = 0;
+  size_t offset = 0;
+  for (; first != last; ++first) {
+    block[filled * 3]     = static_cast<float>(first->x);
+    block[filled * 3 + 1] = static_cast<float>(first->y);
+    block[filled * 3 + 2] = static_cast<float>(first->z);
+    if (++filled == kBlockPoints) {
+      encode(block, offset, filled);
+      offset += filled;
+      filled = 0;
+    }
+  }
+  if (filled > 0) {
+    encode(block, offset, filled);
+  }
+}
+
+template<typename V, typename OutIt, typename Decode>
+auto decodeBlocks(size_t points, OutIt out, Decode decode) -> OutIt {
+  float block[kBlockPoints * 3];
+  for (size_t offset = 0; offset < points; offset += kBlockPoints) {
+    const size_t count = std::min(kBlockPoints, points - offset);
+    decode(offset, count, block);
+    for (size_t i = 0; i < count; ++i) {
+      *out++ = V(block[i * 3], block[i * 3 + 1], block[i * 3 + 2]);
+    }
+  }
+  return out;
+}
+
+}   // namespace detail
+
+// ---------------------------------------------------------------------------
+// 压缩数组
+// ---------------------------------------------------------------------------
+
+template<typename V> class HalfVector3Array {
+  public:
+  using value_type     = V;
+  using const_iterator = DecodingIterator<HalfVector3Array>;
+
+  HalfVector3Array() = default;
+
+  template<typename It> HalfVector3Array(It first, It last) { assign(first, last); }
+
+  template<typename It> void assign(It first, It last) {
+    data_.assign(static_cast<size_t>(std::distance(first, last)) * 3, 0);
+    detail::encodeBlocks(first, last, [this](const float* block, size_t offset, size_t count) {
+      encodeHalf(block, data_.data() + offset * 3, count * 3);
+    });
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return data_.size() / 3; }
+  [[nodiscard]] auto bytes() const -> size_t { return data_.size() * sizeof(uint16_t); }
+
+  auto operator[](size_t i) const -> V {
+    return V(
+      halfToFloat(data_[i * 3]), halfToFloat(data_[i * 3 + 1]), halfToFloat(data_[i * 3 + 2]));
+  }
+
+  // 批量解码全部点，比逐个解引用迭代器更快
+  template<typename OutIt> auto decodeAll(OutIt out) const -> OutIt {
+    return detail::decodeBlocks<V>(size(), out, [this](size_t offset, size_t count, float* block) {
+      decodeHalf(data_.data() + offset * 3, block, count * 3);
+    });
+  }
+
+  [[nodiscard]] auto begin() const -> const_iterator { return const_iterator(this, 0); }
+  [[nodiscard]] auto end() const -> const_iterator { return const_iterator(this, size()); }
+
+  private:
+  std::vector<uint16_t> data_;   // xyz 交错存储
+};
+
+template<typename V> class QuantizedVector3Array {
+  public:
+  using value_type     = V;
+  using const_iterator = DecodingIterator<QuantizedVector3Array>;
+
+  QuantizedVector3Array() = default;
+
+  // 包围盒由调用方给出，超出范围的坐标会被截断到边界
+  template<typename It>
+  QuantizedVector3Array(It first, It last, const Bounds& bounds)
+    : quantizer_(bounds) {
+    assign(first, last);
+  }
+
+  // 先扫描一遍求包围盒，再量化
+  template<typename It> static auto fromRange(It first, It last) -> QuantizedVector3Array {
+    return QuantizedVector3Array(first, last, computeBounds(first, last));
+  }
+
+  template<typename It> static auto computeBounds(It first, It last) -> Bounds {
+    Bounds bounds;
+    if (first == last) {
+      return bounds;
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+      bounds.min[axis] = std::numeric_limits<float>::max();
+      bounds.max[axis] = std::numeric_limits<float>::lowest();
+    }
+    for (; first != last; ++first) {
+      const float p[3] = {
+        static_cast<float>(first->x), static_cast<float>(first->y), static_cast<float>(first->z)};
+      for (int axis = 0; axis < 3; ++axis) {
+        bounds.min[axis] = std::min(bounds.min[axis], p[axis]);
+        bounds.max[axis] = std::max(bounds.max[axis], p[axis]);
+      }
+    }
+    return bounds;
+  }
+
+  template<typename It> void assign(It first, It last) {
+    data_.assign(static_cast<size_t>(std::distance(first, last)) * 3, 0);
+    detail::encodeBlocks(first, last, [this](const float* block, size_t offset, size_t count) {
+      quantizer_.encode(block, data_.data() + offset * 3, count);
+    });
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return data_.size() / 3; }
+  [[nodiscard]] auto bytes() const -> size_t { return data_.size() * sizeof(uint16_t); }
+  [[nodiscard]] auto bounds() const -> const Bounds& { return quantizer_.bounds(); }
+
+  auto operator[](size_t i) const -> V {
+    float p[3];
+    quantizer_.decode(data_.data() + i * 3, p, 1);
+    return V(p[0], p[1], p[2]);
+  }
+
+  template<typename OutIt> auto decodeAll(OutIt out) const -> OutIt {
+    return detail::decodeBlocks<V>(size(), out, [this](size_t offset, size_t count, float* block) {
+      quantizer_.decode(data_.data() + offset * 3, block, count);
+    });
+  }
+
+  [[nodiscard]] auto begin() const -> const_iterator { return const_iterator(this, 0); }
+  [[nodiscard]] auto end() const -> const_iterator { return const_iterator(this, size()); }
+
+  private:
+  Quantizer             quantizer_;
+  std::vector<uint16_t> data_;
+};
+
+// 只适用于单位向量（法线），输入无需预先归一化，解码结果总是单位长度
+template<typename V> class OctahedralNormalArray {
+  public:
+  using value_type     = V;
+  using const_iterator = DecodingIterator<OctahedralNormalArray>;
+
+  OctahedralNormalArray() = default;
+
+  template<typename It> OctahedralNormalArray(It first, It last) { assign(first, last); }
+
+  template<typename It> void assign(It first, It last) {
+    data_.assign(static_cast<size_t>(std::distance(first, last)) * 2, 0);
+    detail::encodeBlocks(first, last, [this](const float* block, size_t offset, size_t count) {
+      encodeOctahedral(block, data_.data() + offset * 2, count);
+    });
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return data_.size() / 2; }
+  [[nodiscard]] auto bytes() const -> size_t { return data_.size() * sizeof(int16_t); }
+
+  auto operator[](size_t i) const -> V {
+    float p[3];
+    decodeOctahedral(data_.data() + i * 2, p, 1);
+    return V(p[0], p[1], p[2]);
+  }
+
+  template<typename OutIt> auto decodeAll(OutIt out) const -> OutIt {
+    return detail::decodeBlocks<V>(size(), out, [this](size_t offset, size_t count, float* block) {
+      decodeOctahedral(data_.data() + offset * 2, block, count);
+    });
+  }
+
+  [[nodiscard]] auto begin() const -> const_iterator { return const_iterator(this, 0); }
+  [[nodiscard]] auto end() const -> const_iterator { return const_iterator(this, size()); }
+
+  private:
+  std::vector<int16_t> data_;   // 每个法线两个 snorm16 分量
+};
+
+}   // namespace vector3_storage
+
+#endif
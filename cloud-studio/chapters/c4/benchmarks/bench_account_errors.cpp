@@ -0,0 +1,80 @@
+/**
+ * @file bench_account_errors.cpp
+ * @brief 比较 BankAccount 的抛异常接口与错误码接口在不同拒绝率下的开销
+ *
+ * 每次操作是一笔取款，其中一部分（拒绝率）金额超过余额：
+ * - withdraw()：余额不足时抛出 std::runtime_error，调用方 catch
+ * - tryWithdraw()：返回 AccountStatus::InsufficientFunds
+ * 成功的取款之后立刻存回同样的金额，余额保持不变。
+ *
+ * 编译运行：clang++ -std=c++17 -O2 bench_account_errors.cpp -o bench && ./bench
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include "../tutorials/bank_account.h"
+
+constexpr size_t kOperations = 2'000'000;
+constexpr Money  kBalance    = Money::units(1'000'000);
+
+static volatile size_t sink;
+
+// 按拒绝率生成取款金额；用 LCG 打乱顺序，避免分支预测器记住规律
+auto makeAmounts(double rejectRate) -> std::vector<Money> {
+  std::vector<Money> amounts(kOperations);
+  uint64_t           state = 42;
+  for (Money& amount : amounts) {
+    state                = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    const double uniform = static_cast<double>(state >> 11) / static_cast<double>(1ULL << 53);
+    amount               = uniform < rejectRate ? kBalance * 2 : Money::units(10);
+  }
+  return amounts;
+}
+
+template<typename F> auto measure(F&& f) -> double {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / kOperations;
+}
+
+auto main() -> int {
+  std::printf("%10s %16s %16s %10s\n", "reject", "throw (ns/op)", "status (ns/op)", "speedup");
+  for (double rejectRate : {0.0, 0.01, 0.1, 0.3, 0.5}) {
+    const std::vector<Money> amounts = makeAmounts(rejectRate);
+
+    BankAccount  throwing("throw", kBalance);
+    const double throwNs = measure([&] {
+      size_t rejected = 0;
+      for (Money amount : amounts) {
+        try {
+          throwing.withdraw(amount);
+          throwing.deposit(amount);
+        } catch (const std::runtime_error&) {
+          ++rejected;
+        }
+      }
+      sink = rejected;
+    });
+
+    BankAccount  checked("status", kBalance);
+    const double statusNs = measure([&] {
+      size_t rejected = 0;
+      for (Money amount : amounts) {
+        if (checked.tryWithdraw(amount) != AccountStatus::Ok ||
+            checked.tryDeposit(amount) != AccountStatus::Ok) {
+          ++rejected;
+        }
+      }
+      sink = rejected;
+    });
+
+    std::printf(
+      "%9.0f%% %16.1f %16.1f %9.1fx\n", rejectRate * 100, throwNs, statusNs, throwNs / statusNs);
+  }
+  return 0;
+}
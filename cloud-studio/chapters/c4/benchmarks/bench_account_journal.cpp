@@ -0,0 +1,109 @@
+/**
+ * @file bench_account_journal.cpp
+ * @brief AccountJournal 在各个 Durability 级别下的提交吞吐量和延迟
+ *
+ * 每个线程持有自己的 BankAccount，共享同一个日志，在固定时间内不断 deposit()。
+ * 记录每次 deposit() 的耗时（包括等待落盘），输出每秒提交数、p50 / p99 延迟
+ * 以及平均每次 fdatasync 落盘的记录数（组提交的批量）。
+ * 日志文件默认写在当前目录（tmpfs 上的 fdatasync 几乎不花时间，看不出差别），可以用第一个参数指定路径。
+ *
+ * 编译运行：clang++ -std=c++17 -O2 -pthread bench_account_journal.cpp -o bench && ./bench [path]
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../tutorials/bank_account.h"
+
+constexpr auto kDuration = std::chrono::milliseconds(500);
+
+struct Result {
+  double commitsPerSecond;
+  double p50Us;
+  double p99Us;
+  double recordsPerSync;
+};
+
+auto run(const std::string& path, Durability durability, size_t threads) -> Result {
+  ::unlink(path.c_str());
+  AccountJournal                   journal(path, durability);
+  std::vector<std::vector<double>> latencies(threads);
+  std::vector<std::thread>         workers;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&journal, &latencies, start, t] {
+      BankAccount account("account-" + std::to_string(t));
+      account.attachJournal(&journal);
+      std::vector<double>& samples = latencies[t];
+      for (auto now = std::chrono::steady_clock::now(); now - start < kDuration;) {
+        account.deposit(Money::units(1));
+        const auto done = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::micro>(done - now).count());
+        now = done;
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  const double seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const uint64_t syncs   = journal.syncs();
+  const uint64_t records = journal.records();
+
+  std::vector<double> all;
+  for (const auto& samples : latencies) {
+    all.insert(all.end(), samples.begin(), samples.end());
+  }
+  std::sort(all.begin(), all.end());
+  const auto percentile = [&all](double p) {
+    return all.empty() ? 0.0 : all[static_cast<size_t>(p * static_cast<double>(all.size() - 1))];
+  };
+  return {
+    static_cast<double>(all.size()) / seconds,
+    percentile(0.50),
+    percentile(0.99),
+    syncs == 0 ? 0.0 : static_cast<double>(records) / static_cast<double>(syncs)};
+}
+
+auto main(int argc, char** argv) -> int {
+  const std::string path = argc > 1 ? argv[1] : "bench_account.journal";
+
+  const std::pair<Durability, const char*> levels[] = {
+    {Durability::Buffered, "Buffered"},
+    {Durability::Written, "Written"},
+    {Durability::GroupSync, "GroupSync"},
+    {Durability::Sync, "Sync"},
+  };
+
+  std::printf(
+    "%-10s %8s %14s %10s %10s %14s\n",
+    "level",
+    "threads",
+    "commits/s",
+    "p50 (us)",
+    "p99 (us)",
+    "records/sync");
+  for (const auto& [durability, name] : levels) {
+    for (size_t threads : {1, 4, 16}) {
+      const Result r = run(path, durability, threads);
+      std::printf(
+        "%-10s %8zu %14.0f %10.1f %10.1f %14.1f\n",
+        name,
+        threads,
+        r.commitsPerSecond,
+        r.p50Us,
+        r.p99Us,
+        r.recordsPerSync);
+    }
+  }
+  ::unlink(path.c_str());
+  return 0;
+}
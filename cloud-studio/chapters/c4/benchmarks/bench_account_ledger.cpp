@@ -0,0 +1,148 @@
+/**
+ * @file bench_account_ledger.cpp
+ * @brief AccountLedger 批量应用交易的吞吐量
+ *
+ * 2^22（约 400 万）个账户、64 个分片，每批 100 万笔交易：30% 存款、30% 取款、40% 转账，
+ * 转账中有 10% 跨分片。基线是 std::vector<BankAccount> 逐笔调用 tryDeposit/tryWithdraw。
+ * 每一轮结束后检查总额是否等于存款减去成功的取款。
+ *
+ * 编译运行：clang++ -std=c++17 -O2 -pthread bench_account_ledger.cpp -o bench && ./bench
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../tutorials/account_ledger.h"
+#include "../tutorials/bank_account.h"
+
+constexpr uint32_t kAccounts  = 1u << 22;   // 约 400 万
+constexpr size_t   kShards    = 64;
+constexpr size_t   kBatch     = 1'000'000;
+constexpr int      kRounds    = 5;
+constexpr int64_t  kInitial   = 10'000;   // 每个账户的初始余额（分）
+constexpr uint32_t kShardSize = kAccounts / kShards;
+
+struct Lcg {
+  uint64_t state;
+  auto     next() -> uint32_t {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<uint32_t>(state >> 33);
+  }
+};
+
+auto makeBatch(uint64_t seed) -> std::vector<Transaction> {
+  std::vector<Transaction> batch;
+  batch.reserve(kBatch);
+  Lcg rng{seed};
+  for (size_t i = 0; i < kBatch; ++i) {
+    const uint32_t account = rng.next() % kAccounts;
+    const auto     amount  = static_cast<int64_t>(rng.next() % 5'000 + 1);
+    const uint32_t kind    = rng.next() % 10;
+    if (kind < 3) {
+      batch.push_back(Transaction::deposit(account, amount));
+    }
+    else if (kind < 6) {
+      batch.push_back(Transaction::withdraw(account, amount));
+    }
+    else {
+      // 90% 的转账发生在同一个分片内（例如同一家分行的客户之间）
+      const uint32_t shardBase = account / kShardSize * kShardSize;
+      const uint32_t to        = rng.next() % 10 == 0 ? rng.next() % kAccounts
+                                                      : shardBase + rng.next() % kShardSize;
+      batch.push_back(Transaction::transfer(account, to, amount));
+    }
+  }
+  return batch;
+}
+
+// 净流入：存款总额减去成功的取款总额
+auto netInflow(const std::vector<Transaction>& batch, const std::vector<AccountStatus>& results)
+  -> int64_t {
+  int64_t net = 0;
+  for (size_t i = 0; i < batch.size(); ++i) {
+    if (results[i] != AccountStatus::Ok) {
+      continue;
+    }
+    if (batch[i].kind == Transaction::Kind::Deposit) {
+      net += batch[i].amount;
+    }
+    else if (batch[i].kind == Transaction::Kind::Withdraw) {
+      net -= batch[i].amount;
+    }
+  }
+  return net;
+}
+
+template<typename F> auto measure(F&& f) -> double {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+auto main() -> int {
+  std::vector<std::vector<Transaction>> batches;
+  for (int r = 0; r < kRounds; ++r) {
+    batches.push_back(makeBatch(static_cast<uint64_t>(r) + 1));
+  }
+  std::vector<AccountStatus> results(kBatch);
+
+  std::printf("hardware threads: %u\n\n", std::thread::hardware_concurrency());
+  std::printf("%-28s %12s %8s\n", "implementation", "Mtx/s", "total");
+
+  {
+    std::vector<BankAccount> accounts;
+    accounts.reserve(kAccounts);
+    for (uint32_t i = 0; i < kAccounts; ++i) {
+      accounts.emplace_back("owner", Money::fromMinor(kInitial));
+    }
+    double seconds = 0;
+    for (const auto& batch : batches) {
+      seconds += measure([&] {
+        for (size_t i = 0; i < batch.size(); ++i) {
+          const Transaction& tx     = batch[i];
+          const Money        amount = Money::fromMinor(tx.amount);
+          AccountStatus      status;
+          if (tx.kind == Transaction::Kind::Deposit) {
+            status = accounts[tx.from].tryDeposit(amount);
+          }
+          else {
+            status = accounts[tx.from].tryWithdraw(amount);
+            if (status == AccountStatus::Ok && tx.kind == Transaction::Kind::Transfer) {
+              status = accounts[tx.to].tryDeposit(amount);
+            }
+          }
+          results[i] = status;
+        }
+      });
+    }
+    std::printf("%-28s %12.2f %8s\n", "vector<BankAccount>", kRounds * kBatch / seconds / 1e6, "-");
+  }
+
+  for (unsigned threads : {1u, 2u, 4u, 8u}) {
+    AccountLedger ledger(kAccounts, kShards, threads);
+    std::vector<Transaction> funding;
+    funding.reserve(kAccounts);
+    for (uint32_t i = 0; i < kAccounts; ++i) {
+      funding.push_back(Transaction::deposit(i, kInitial));
+    }
+    ledger.apply(funding);
+
+    int64_t expected = static_cast<int64_t>(kAccounts) * kInitial;
+    double  seconds  = 0;
+    for (const auto& batch : batches) {
+      seconds += measure([&] { ledger.apply(batch, results.data()); });
+      expected += netInflow(batch, results);
+    }
+    const std::string name = "AccountLedger x" + std::to_string(threads) + " threads";
+    std::printf(
+      "%-28s %12.2f %8s\n",
+      name.c_str(),
+      kRounds * kBatch / seconds / 1e6,
+      ledger.totalBalance() == expected ? "ok" : "MISMATCH");
+  }
+  return 0;
+}
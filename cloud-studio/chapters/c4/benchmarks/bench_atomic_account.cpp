@@ -0,0 +1,113 @@
+/**
+ * @file bench_atomic_account.cpp
+ * @brief 比较 AtomicBankAccount（CAS）与加互斥锁的账户在 1 ~ 32 个线程下的吞吐量
+ *
+ * 所有线程操作同一个账户（竞争最激烈的情况），每个线程交替存款和取款；
+ * 结束后检查余额与成功的存取款是否对得上，并且从未出现负数。
+ *
+ * 编译运行：clang++ -std=c++17 -O2 -pthread bench_atomic_account.cpp -o bench && ./bench
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../tutorials/atomic_account.h"
+
+constexpr size_t  kOperations = 1'000'000;   // 每个线程
+constexpr Money   kInitial    = Money::fromMinor(1'000);
+
+// 基线：与 AtomicBankAccount 接口相同，用 std::mutex 保护一个 Money
+class MutexBankAccount {
+  public:
+  explicit MutexBankAccount(Money initial)
+    : balance_(initial) {}
+
+  [[nodiscard]] auto tryDeposit(Money amount) -> AccountStatus {
+    std::lock_guard<std::mutex> lock(mutex_);
+    balance_ += amount;
+    return AccountStatus::Ok;
+  }
+
+  [[nodiscard]] auto tryWithdraw(Money amount) -> AccountStatus {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (balance_ < amount) {
+      return AccountStatus::InsufficientFunds;
+    }
+    balance_ -= amount;
+    return AccountStatus::Ok;
+  }
+
+  [[nodiscard]] auto getBalance() const -> Money {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return balance_;
+  }
+
+  private:
+  mutable std::mutex mutex_;
+  Money              balance_;
+};
+
+struct Result {
+  double mtps;   // 每秒百万笔交易
+  bool   consistent;
+};
+
+template<typename Account> auto run(size_t threads) -> Result {
+  Account              account(kInitial);
+  std::atomic<int64_t> deposited{0};
+  std::atomic<int64_t> withdrawn{0};
+
+  const auto               start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&account, &deposited, &withdrawn, t] {
+      int64_t in  = 0;
+      int64_t out = 0;
+      for (size_t i = 0; i < kOperations; ++i) {
+        // 取款金额略大于存款，保证会出现余额不足的情况
+        const auto amount = static_cast<int64_t>((i + t) % 7 + 1);
+        if (i % 2 == 0) {
+          if (account.tryDeposit(Money::fromMinor(amount)) == AccountStatus::Ok) {
+            in += amount;
+          }
+        }
+        else if (account.tryWithdraw(Money::fromMinor(amount + 1)) == AccountStatus::Ok) {
+          out += amount + 1;
+        }
+      }
+      deposited.fetch_add(in);
+      withdrawn.fetch_add(out);
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  const auto   stop    = std::chrono::steady_clock::now();
+  const double seconds = std::chrono::duration<double>(stop - start).count();
+
+  const int64_t expected = kInitial.minor() + deposited.load() - withdrawn.load();
+  const int64_t balance  = account.getBalance().minor();
+  return {
+    static_cast<double>(kOperations * threads) / seconds / 1e6, balance == expected && balance >= 0};
+}
+
+auto main() -> int {
+  std::printf("hardware threads: %u\n\n", std::thread::hardware_concurrency());
+  std::printf("%8s %16s %16s %8s\n", "threads", "mutex", "atomic/CAS", "speedup");
+  for (size_t threads : {1, 2, 4, 8, 16, 32}) {
+    const Result locked   = run<MutexBankAccount>(threads);
+    const Result lockFree = run<AtomicBankAccount>(threads);
+    std::printf(
+      "%8zu %10.1f Mtx/s %10.1f Mtx/s %7.2fx%s\n",
+      threads,
+      locked.mtps,
+      lockFree.mtps,
+      lockFree.mtps / locked.mtps,
+      locked.consistent && lockFree.consistent ? "" : "  (balance mismatch!)");
+  }
+  return 0;
+}
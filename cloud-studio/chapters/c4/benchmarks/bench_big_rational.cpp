@@ -0,0 +1,171 @@
+/**
+ * @file bench_big_rational.cpp
+ * @brief BigRational 的小数值快速路径、大数乘法（Karatsuba）与 gcd（Lehmer）
+ *
+ * 1. 常见情况：bench_rational.cpp 的乘加链（值都在 64 位以内），比较 Rational64 与 BigRational，
+ *    两者每步耗时应当相近，而且 BigRational 全程不分配内存
+ * 2. 超出 64 位：调和级数 H(n) = 1 + 1/2 + ... + 1/n，分母很快超过 64 位；
+ *    再逐项减回去，结果回到 0 并恢复内联表示
+ * 3. 乘法：n 个 limb 的两个数，逐位相乘与 Karatsuba 的耗时
+ * 4. gcd：两个 n limb 的数（有一个 n/2 limb 的公因子），逐步做多精度除法的欧几里得算法与 Lehmer 算法
+ *
+ * 编译运行：clang++ -std=c++17 -O2 bench_big_rational.cpp -o bench && ./bench
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "../tutorials/big_rational.h"
+
+constexpr size_t kSteps = 1'000'000;
+
+template<typename F> auto measure(int rounds, F&& f) -> double {
+  double best = 1e300;
+  for (int round = 0; round < rounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto   stop = std::chrono::steady_clock::now();
+    const double ns   = std::chrono::duration<double, std::nano>(stop - start).count();
+    best              = ns < best ? ns : best;
+  }
+  return best;
+}
+
+auto randomLimbs(std::mt19937_64& rng, size_t count) -> big_detail::Limbs {
+  big_detail::Limbs limbs(count);
+  for (auto& limb : limbs) {
+    limb = rng();
+  }
+  limbs.back() |= 1;
+  return limbs;
+}
+
+// 对照组：每一步都做一次完整的多精度除法
+auto euclidGcd(big_detail::Limbs u, big_detail::Limbs v) -> big_detail::Limbs {
+  big_detail::Limbs quotient;
+  big_detail::Limbs remainder;
+  while (!v.empty()) {
+    big_detail::divide(u, v, quotient, remainder);
+    u = std::move(v);
+    v = std::move(remainder);
+  }
+  return u;
+}
+
+void smallValues(std::mt19937_64& rng) {
+  static constexpr int64_t kDenominators[] = {1, 2, 3, 4, 5, 6, 8, 10, 12, 15, 20, 30, 60};
+  std::uniform_int_distribution<size_t>  pick(0, std::size(kDenominators) - 1);
+  std::uniform_int_distribution<int64_t> numerator(-50, 50);
+  std::vector<Rational64>                small(2 * kSteps);
+  for (auto& value : small) {
+    value = Rational64(numerator(rng), kDenominators[pick(rng)]);
+  }
+  const std::vector<BigRational> big(small.begin(), small.end());
+
+  Rational64  smallSum;
+  BigRational bigSum;
+  const double smallNs = measure(5, [&] {
+    smallSum = 0;
+    for (size_t i = 0; i < kSteps; ++i) {
+      smallSum += small[2 * i] * small[2 * i + 1];
+    }
+  });
+  const double bigNs = measure(5, [&] {
+    bigSum = 0;
+    for (size_t i = 0; i < kSteps; ++i) {
+      bigSum += big[2 * i] * big[2 * i + 1];
+    }
+  });
+  std::printf("1. multiply-add chain, values within 64 bits (ns/step)\n");
+  std::printf("   %-14s %8.2f\n", "Rational64", smallNs / kSteps);
+  std::printf("   %-14s %8.2f   inline: %s, same result: %s\n\n",
+              "BigRational",
+              bigNs / kSteps,
+              bigSum.isInline() ? "yes" : "no",
+              bigSum.isInline() && bigSum.small() == smallSum ? "yes" : "NO");
+}
+
+void harmonic() {
+  std::printf("2. harmonic numbers H(n)\n");
+  std::printf("   %8s %14s %12s %12s\n", "n", "denominator", "sum ms", "undo ms");
+  for (int64_t n : {100, 1'000, 5'000}) {
+    BigRational  sum;
+    const double sumNs = measure(1, [&] {
+      sum = 0;
+      for (int64_t k = 1; k <= n; ++k) {
+        sum += BigRational(1, k);
+      }
+    });
+    const size_t digits = sum.denominator().toString().size();
+    const double undoNs = measure(1, [&] {
+      for (int64_t k = n; k >= 1; --k) {
+        sum -= BigRational(1, k);
+      }
+    });
+    std::printf("   %8lld %8zu digits %12.2f %12.2f   back to inline 0: %s\n",
+                static_cast<long long>(n),
+                digits,
+                sumNs / 1e6,
+                undoNs / 1e6,
+                sum.isInline() && sum == 0 ? "yes" : "NO");
+  }
+  std::printf("\n");
+}
+
+void multiplication(std::mt19937_64& rng) {
+  std::printf("3. multiplication (us)\n");
+  std::printf("   %8s %12s %12s\n", "limbs", "schoolbook", "karatsuba");
+  for (size_t n : {16, 64, 256, 1'024, 4'096}) {
+    const auto        a = randomLimbs(rng, n);
+    const auto        b = randomLimbs(rng, n);
+    big_detail::Limbs schoolbook(2 * n);
+    big_detail::Limbs karatsuba;
+    const int         rounds = n <= 256 ? 20 : 3;
+    const double      slowNs = measure(rounds, [&] {
+      std::fill(schoolbook.begin(), schoolbook.end(), 0);
+      big_detail::mulSchoolbook(a.data(), n, b.data(), n, schoolbook.data());
+    });
+    const double      fastNs = measure(rounds, [&] { karatsuba = big_detail::multiply(a, b); });
+    big_detail::trim(schoolbook);
+    std::printf("   %8zu %12.1f %12.1f%s\n",
+                n,
+                slowNs / 1e3,
+                fastNs / 1e3,
+                schoolbook == karatsuba ? "" : "   MISMATCH");
+  }
+  std::printf("\n");
+}
+
+void greatestCommonDivisor(std::mt19937_64& rng) {
+  std::printf("4. gcd (us)\n");
+  std::printf("   %8s %12s %12s\n", "limbs", "euclid", "lehmer");
+  for (size_t n : {4, 16, 64, 256}) {
+    const auto   common = randomLimbs(rng, n / 2);
+    const auto   u      = big_detail::multiply(randomLimbs(rng, n / 2), common);
+    const auto   v      = big_detail::multiply(randomLimbs(rng, n / 2), common);
+    const int    rounds = n <= 64 ? 20 : 3;
+    auto         slow   = euclidGcd(u, v);
+    auto         fast   = big_detail::gcd(u, v);
+    const double slowNs = measure(rounds, [&] { slow = euclidGcd(u, v); });
+    const double fastNs = measure(rounds, [&] { fast = big_detail::gcd(u, v); });
+    std::printf("   %8zu %12.1f %12.1f%s\n",
+                n,
+                slowNs / 1e3,
+                fastNs / 1e3,
+                slow == fast ? "" : "   MISMATCH");
+  }
+}
+
+auto main() -> int {
+  std::mt19937_64 rng(42);
+  smallValues(rng);
+  harmonic();
+  multiplication(rng);
+  greatestCommonDivisor(rng);
+  return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file bench_garage.cpp
+ * @brief 比较 Garage 两种存放方式下 startAllVehicles() 的开销（1000 万辆车，三种车型随机混合）
+ *
+ * - unique_ptr：addVehicle()，每辆车单独分配，遍历时车型顺序随机
+ * - segmented：emplaceVehicle<T>()，按车型分段连续存放，仍通过 Vehicle& 做虚函数调用
+ * - segmented + restituted：startAllVehicles<Sedan, Truck, Motorbike>()，车型都是 final 类，
+ *   start() 被去虚化并内联
+ *
+ * 编译运行：clang++ -std=c++17 -O2 bench_garage.cpp -o bench && ./bench
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+#include "../tutorials/garage.h"
+
+constexpr size_t kVehicles = 10'000'000;
+constexpr int    kRounds   = 5;
+
+// 三种不输出日志的车型，start() 各做一点不同的工作
+class Sedan final : public Vehicle {
+  public:
+  void start() override {
+    engineRunning_ = true;
+    gear_          = 1;
+  }
+  void stop() override {
+    engineRunning_ = false;
+    gear_          = 0;
+  }
+
+  private:
+  int32_t gear_ = 0;
+};
+
+class Truck final : public Vehicle {
+  public:
+  void start() override {
+    engineRunning_ = true;
+    rpm_ += 800;
+  }
+  void stop() override {
+    engineRunning_ = false;
+    rpm_           = 0;
+  }
+
+  private:
+  int32_t rpm_  = 0;
+  int32_t load_ = 12'000;
+};
+
+class Motorbike final : public Vehicle {
+  public:
+  void start() override {
+    engineRunning_ = true;
+    ++kicks_;
+  }
+  void stop() override { engineRunning_ = false; }
+
+  private:
+  uint16_t kicks_ = 0;
+};
+
+// 用同一个随机序列决定每辆车的车型
+template<typename Add> void fill(Add&& add) {
+  uint64_t state = 42;
+  for (size_t i = 0; i < kVehicles; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    add(static_cast<int>((state >> 33) % 3));
+  }
+}
+
+template<typename F> auto measure(F&& f) -> double {
+  double best = 1e300;
+  for (int round = 0; round < kRounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto   stop = std::chrono::steady_clock::now();
+    const double ns   = std::chrono::duration<double, std::nano>(stop - start).count() / kVehicles;
+    best              = ns < best ? ns : best;
+  }
+  return best;
+}
+
+auto main() -> int {
+  std::printf("%-28s %12s %10s\n", "storage", "ns/vehicle", "speedup");
+
+  double baseline = 0;
+  {
+    Garage garage;
+    fill([&garage](int kind) {
+      if (kind == 0) {
+        garage.addVehicle(std::make_unique<Sedan>());
+      }
+      else if (kind == 1) {
+        garage.addVehicle(std::make_unique<Truck>());
+      }
+      else {
+        garage.addVehicle(std::make_unique<Motorbike>());
+      }
+    });
+    baseline = measure([&garage] { garage.startAllVehicles(); });
+    std::printf("%-28s %12.3f %9.2fx\n", "unique_ptr", baseline, 1.0);
+  }
+
+  Garage garage;
+  garage.reserveVehicles<Sedan>(kVehicles / 3 + 1'000);
+  garage.reserveVehicles<Truck>(kVehicles / 3 + 1'000);
+  garage.reserveVehicles<Motorbike>(kVehicles / 3 + 1'000);
+  fill([&garage](int kind) {
+    if (kind == 0) {
+      garage.emplaceVehicle<Sedan>();
+    }
+    else if (kind == 1) {
+      garage.emplaceVehicle<Truck>();
+    }
+    else {
+      garage.emplaceVehicle<Motorbike>();
+    }
+  });
+
+  const double segmented = measure([&garage] { garage.startAllVehicles(); });
+  std::printf("%-28s %12.3f %9.2fx\n", "segmented", segmented, baseline / segmented);
+
+  const double restituted =
+    measure([&garage] { garage.startAllVehicles<Sedan, Truck, Motorbike>(); });
+  std::printf(
+    "%-28s %12.3f %9.2fx\n", "segmented + restituted", restituted, baseline / restituted);
+  return garage.vehicleCount() == kVehicles ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file bench_page_cache.cpp
+ * @brief Zipf 分布的 URL 访问下，PageCache 与 std::list + std::unordered_map 的 LRU 对比
+ *
+ * 10 万个 URL，页面大小 64～1024 字节；200 万次访问按 Zipf(0.99) 分布（少数热门页面占大部分访问），
+ * 未命中时把页面放进缓存。两种实现的淘汰顺序相同，命中率应当一致，只比较每次访问的耗时：
+ * - StdListLru：教科书写法，std::list 保存 (URL, 内容)，哈希表的值是链表迭代器，
+ *   每个新页面分配链表节点和哈希表元素两次，URL 存两份
+ * - PageCache：侵入式链表，页面节点就是哈希表的值（page_cache.h）
+ * 最后测量 clear()：缓存曾经有 10 万个页面后，反复"插入 10 个页面再清空"。
+ * std::unordered_map::clear() 每次都要把曾经扩大的桶数组清零，PageCache 换上新的空表。
+ *
+ * 编译运行：clang++ -std=c++17 -O2 bench_page_cache.cpp -o bench && ./bench
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../tutorials/page_cache.h"
+
+constexpr size_t kUrls     = 100'000;
+constexpr size_t kRequests = 2'000'000;
+
+// 教科书写法的对照组，预算和占用的算法与 PageCache 相同
+class StdListLru {
+  public:
+  explicit StdListLru(size_t byteBudget)
+    : budget_(byteBudget) {}
+
+  auto get(const std::string& url) -> const std::string* {
+    const auto it = index_.find(url);
+    if (it == index_.end()) {
+      ++stats_.misses;
+      return nullptr;
+    }
+    ++stats_.hits;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return &it->second->body;
+  }
+
+  void put(const std::string& url, const std::string& body) {
+    const size_t charge = page_cache_detail::chargeOf(url, body);
+    lru_.push_front({url, body, charge});
+    index_[url] = lru_.begin();
+    bytes_ += charge;
+    while (bytes_ > budget_) {
+      bytes_ -= lru_.back().charge;
+      index_.erase(lru_.back().url);
+      lru_.pop_back();
+      ++stats_.evictions;
+    }
+  }
+
+  void clear() {
+    lru_.clear();
+    index_.clear();
+    bytes_ = 0;
+  }
+
+  [[nodiscard]] auto stats() const -> const CacheStats& { return stats_; }
+
+  private:
+  struct Entry {
+    std::string url;
+    std::string body;
+    size_t      charge;
+  };
+
+  size_t                                                      budget_;
+  size_t                                                      bytes_ = 0;
+  std::list<Entry>                                            lru_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  CacheStats                                                  stats_;
+};
+
+// 按累积分布函数二分查找；排名打乱后再映射到 URL，热门页面不集中在编号小的一端
+auto zipfTrace(size_t universe, size_t count, double skew, std::mt19937_64& rng)
+  -> std::vector<uint32_t> {
+  std::vector<double> cdf(universe);
+  double              sum = 0;
+  for (size_t rank = 0; rank < universe; ++rank) {
+    sum += 1.0 / std::pow(static_cast<double>(rank + 1), skew);
+    cdf[rank] = sum;
+  }
+  std::vector<uint32_t> id(universe);
+  for (size_t i = 0; i < universe; ++i) {
+    id[i] = static_cast<uint32_t>(i);
+  }
+  std::shuffle(id.begin(), id.end(), rng);
+
+  std::uniform_real_distribution<double> uniform(0.0, sum);
+  std::vector<uint32_t>                  trace(count);
+  for (auto& request : trace) {
+    const size_t rank = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+    request           = id[std::min(rank, universe - 1)];
+  }
+  return trace;
+}
+
+template<typename F> auto measureOnce(F&& f) -> double {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count();
+}
+
+// 回放访问序列：未命中时放进缓存。返回每次访问的纳秒数
+template<typename Cache>
+auto replay(Cache&                          cache,
+            const std::vector<uint32_t>&    trace,
+            const std::vector<std::string>& urls,
+            const std::vector<std::string>& bodies) -> double {
+  const double ns = measureOnce([&] {
+    for (const uint32_t id : trace) {
+      if (cache.get(urls[id]) == nullptr) {
+        cache.put(urls[id], bodies[id]);
+      }
+    }
+  });
+  return ns / static_cast<double>(trace.size());
+}
+
+// 缓存曾经很大之后，反复插入少量页面再清空；返回每次 clear() 的纳秒数
+template<typename Cache>
+auto smallClears(Cache& cache, const std::vector<std::string>& urls, const std::string& body)
+  -> double {
+  for (const auto& url : urls) {
+    cache.put(url, body);
+  }
+  cache.clear();
+  constexpr int kClears = 2'000;
+  double        ns      = 0;
+  for (int round = 0; round < kClears; ++round) {
+    for (size_t i = 0; i < 10; ++i) {
+      cache.put(urls[i], body);
+    }
+    ns += measureOnce([&] { cache.clear(); });
+  }
+  return ns / kClears;
+}
+
+auto main() -> int {
+  std::mt19937_64                       rng(42);
+  std::vector<std::string>              urls(kUrls);
+  std::vector<std::string>              bodies(kUrls);
+  size_t                                totalBytes = 0;
+  std::uniform_int_distribution<size_t> pageSize(64, 1024);
+  for (size_t i = 0; i < kUrls; ++i) {
+    urls[i] =
+      "https://site-" + std::to_string(i % 977) + ".example.com/page/" + std::to_string(i);
+    bodies[i] = std::string(pageSize(rng), 'x');
+    totalBytes += page_cache_detail::chargeOf(urls[i], bodies[i]);
+  }
+  const auto trace = zipfTrace(kUrls, kRequests, 0.99, rng);
+
+  std::printf("Zipf(0.99), %zu URLs, %zu requests, all pages = %.1f MB\n\n",
+              kUrls,
+              kRequests,
+              static_cast<double>(totalBytes) / 1e6);
+  std::printf(
+    "%8s %14s %10s %12s %12s\n", "budget", "cache", "hit rate", "ns/request", "evictions");
+  for (const double fraction : {0.01, 0.05, 0.20}) {
+    const auto budget = static_cast<size_t>(static_cast<double>(totalBytes) * fraction);
+
+    StdListLru   naive(budget);
+    const double naiveNs = replay(naive, trace, urls, bodies);
+    PageCache    cache(budget);
+    const double cacheNs = replay(cache, trace, urls, bodies);
+
+    std::printf("%7.0f%% %14s %9.1f%% %12.1f %12llu\n",
+                fraction * 100,
+                "StdListLru",
+                naive.stats().hitRate() * 100,
+                naiveNs,
+                static_cast<unsigned long long>(naive.stats().evictions));
+    std::printf("%8s %14s %9.1f%% %12.1f %12llu\n",
+                "",
+                "PageCache",
+                cache.stats().hitRate() * 100,
+                cacheNs,
+                static_cast<unsigned long long>(cache.stats().evictions));
+  }
+
+  StdListLru naive(SIZE_MAX);
+  PageCache  cache(SIZE_MAX);
+  std::printf("\nclear() of 10 pages after the cache once held %zu pages (ns)\n", kUrls);
+  std::printf("%14s %12.1f\n", "StdListLru", smallClears(naive, urls, bodies[0]));
+  std::printf("%14s %12.1f\n", "PageCache", smallClears(cache, urls, bodies[0]));
+  return 0;
+}
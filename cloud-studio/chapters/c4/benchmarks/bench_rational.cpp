@@ -0,0 +1,212 @@
+/**
+ * @file bench_rational.cpp
+ * @brief 比较不约分的有理数、"先乘后约分"的有理数与 Rational64 在长运算链上的表现
+ *
+ * 两条运算链：
+ * - 乘法链：因子是小分数 p/q 和它们的倒数，打乱后每 16 个一组，每组的乘积都是 1
+ * - 乘加链：sum += a_i * b_i，分母都是 3600 的约数，所以累加和的分母一直不超过 3600
+ * 三种实现：
+ * - tutorial_24：RationalNonMember 的做法，int 分子分母直接相乘、交叉相乘，从不约分；
+ *   这里用带溢出检查的副本（真正的 int 溢出是未定义行为）统计第几步开始溢出
+ * - naive reduce：int64_t，先算出完整的乘积再用 std::gcd（欧几里得算法，每步一次除法）约分
+ * - Rational64：交叉约分 + 二进制 GCD + 128 位中间结果，见 rational.h
+ * 后两种的结果必须相同。
+ *
+ * 编译运行：clang++ -std=c++17 -O2 bench_rational.cpp -o bench && ./bench
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../tutorials/rational.h"
+
+constexpr size_t kSteps  = 1'000'000;
+constexpr int    kRounds = 5;
+
+struct Fraction {
+  int64_t num;
+  int64_t den;
+};
+
+// tutorial_24 的 operator*（以及同样写法的加法），但在 int 溢出时报告而不是回绕
+struct UnreducedInt {
+  int num = 0;
+  int den = 1;
+
+  auto multiply(const Fraction& rhs) -> bool {
+    return !__builtin_mul_overflow(num, static_cast<int>(rhs.num), &num) &&
+           !__builtin_mul_overflow(den, static_cast<int>(rhs.den), &den);
+  }
+
+  auto add(const UnreducedInt& rhs) -> bool {
+    int lhsNum = 0;
+    int rhsNum = 0;
+    return !__builtin_mul_overflow(num, rhs.den, &lhsNum) &&
+           !__builtin_mul_overflow(rhs.num, den, &rhsNum) &&
+           !__builtin_add_overflow(lhsNum, rhsNum, &num) &&
+           !__builtin_mul_overflow(den, rhs.den, &den);
+  }
+};
+
+// 先乘后约分：结果正确，但每步都对完整乘积做欧几里得 GCD
+struct NaiveReduced {
+  int64_t num = 0;
+  int64_t den = 1;
+
+  void normalize() {
+    const int64_t g = std::gcd(num, den);
+    num /= g;
+    den /= g;
+  }
+
+  void multiply(const Fraction& rhs) {
+    num *= rhs.num;
+    den *= rhs.den;
+    normalize();
+  }
+
+  void add(const NaiveReduced& rhs) {
+    num = num * rhs.den + rhs.num * den;
+    den *= rhs.den;
+    normalize();
+  }
+};
+
+auto multiplyChain(std::mt19937_64& rng) -> std::vector<Fraction> {
+  static constexpr int64_t kSmall[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+  std::uniform_int_distribution<size_t> pick(0, std::size(kSmall) - 1);
+  std::vector<Fraction>                 factors;
+  factors.reserve(kSteps);
+  while (factors.size() < kSteps) {
+    std::vector<Fraction> block;
+    for (int i = 0; i < 8; ++i) {
+      const Fraction f{kSmall[pick(rng)], kSmall[pick(rng)]};
+      block.push_back(f);
+      block.push_back({f.den, f.num});
+    }
+    std::shuffle(block.begin(), block.end(), rng);
+    factors.insert(factors.end(), block.begin(), block.end());
+  }
+  return factors;
+}
+
+// 分母取自 3600 的约数，分子较小，a_i * b_i 的分母也整除 3600
+auto multiplyAddChain(std::mt19937_64& rng) -> std::vector<Fraction> {
+  static constexpr int64_t kDenominators[] = {1, 2, 3, 4, 5, 6, 8, 10, 12, 15, 20, 30, 60};
+  std::uniform_int_distribution<size_t>  pick(0, std::size(kDenominators) - 1);
+  std::uniform_int_distribution<int64_t> numerator(-50, 50);
+  std::vector<Fraction>                  operands(2 * kSteps);
+  for (auto& f : operands) {
+    f = {numerator(rng), kDenominators[pick(rng)]};
+  }
+  return operands;
+}
+
+template<typename F> auto measure(F&& f) -> double {
+  double best = 1e300;
+  for (int round = 0; round < kRounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto   stop = std::chrono::steady_clock::now();
+    const double ns   = std::chrono::duration<double, std::nano>(stop - start).count() / kSteps;
+    best              = ns < best ? ns : best;
+  }
+  return best;
+}
+
+void reportOverflow(const char* chain, size_t step) {
+  if (step < kSteps) {
+    std::printf("%-18s tutorial_24 (int, unreduced) overflows at step %zu\n", chain, step + 1);
+  } else {
+    std::printf("%-18s tutorial_24 (int, unreduced) did not overflow\n", chain);
+  }
+}
+
+auto main() -> int {
+  std::mt19937_64 rng(42);
+  const auto      factors  = multiplyChain(rng);
+  const auto      operands = multiplyAddChain(rng);
+
+  size_t       step = 0;
+  UnreducedInt product{1, 1};
+  while (step < kSteps && product.multiply(factors[step])) {
+    ++step;
+  }
+  reportOverflow("multiply chain:", step);
+
+  UnreducedInt sum;
+  for (step = 0; step < kSteps; ++step) {
+    UnreducedInt term{static_cast<int>(operands[2 * step].num),
+                      static_cast<int>(operands[2 * step].den)};
+    if (!term.multiply(operands[2 * step + 1]) || !sum.add(term)) {
+      break;
+    }
+  }
+  reportOverflow("multiply-add chain:", step);
+
+  // 两种实现各自以最简形式保存操作数，计时只包含运算本身
+  std::vector<NaiveReduced> naiveOperands(operands.size());
+  std::vector<Rational64>   fastFactors(factors.size());
+  std::vector<Rational64>   fastOperands(operands.size());
+  for (size_t i = 0; i < operands.size(); ++i) {
+    naiveOperands[i] = {operands[i].num, operands[i].den};
+    naiveOperands[i].normalize();
+    fastOperands[i] = Rational64(operands[i].num, operands[i].den);
+  }
+  for (size_t i = 0; i < factors.size(); ++i) {
+    fastFactors[i] = Rational64(factors[i].num, factors[i].den);
+  }
+
+  NaiveReduced naiveProduct;
+  NaiveReduced naiveSum;
+  Rational64   fastProduct;
+  Rational64   fastSum;
+
+  std::printf("\n%-22s %16s %16s\n", "implementation", "mul ns/step", "mul+add ns/step");
+  const double naiveMul = measure([&] {
+    naiveProduct = {1, 1};
+    for (const auto& f : factors) {
+      naiveProduct.multiply(f);
+    }
+  });
+  const double naiveMulAdd = measure([&] {
+    naiveSum = {0, 1};
+    for (size_t i = 0; i < kSteps; ++i) {
+      NaiveReduced term = naiveOperands[2 * i];
+      term.multiply({naiveOperands[2 * i + 1].num, naiveOperands[2 * i + 1].den});
+      naiveSum.add(term);
+    }
+  });
+  std::printf("%-22s %16.2f %16.2f\n", "naive reduce (int64)", naiveMul, naiveMulAdd);
+
+  const double fastMul = measure([&] {
+    fastProduct = 1;
+    for (const auto& f : fastFactors) {
+      fastProduct *= f;
+    }
+  });
+  const double fastMulAdd = measure([&] {
+    fastSum = 0;
+    for (size_t i = 0; i < kSteps; ++i) {
+      fastSum += fastOperands[2 * i] * fastOperands[2 * i + 1];
+    }
+  });
+  std::printf("%-22s %16.2f %16.2f\n", "Rational64", fastMul, fastMulAdd);
+
+  const bool same = naiveProduct.num == fastProduct.numerator() &&
+                    naiveProduct.den == fastProduct.denominator() &&
+                    naiveSum.num == fastSum.numerator() && naiveSum.den == fastSum.denominator();
+  std::printf("\nproduct = %lld/%lld, sum = %lld/%lld, results match: %s\n",
+              static_cast<long long>(fastProduct.numerator()),
+              static_cast<long long>(fastProduct.denominator()),
+              static_cast<long long>(fastSum.numerator()),
+              static_cast<long long>(fastSum.denominator()),
+              same ? "yes" : "NO");
+  return same ? 0 : 1;
+}
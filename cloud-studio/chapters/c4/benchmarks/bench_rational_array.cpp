@@ -0,0 +1,184 @@
+/**
+ * @file bench_rational_array.cpp
+ * @brief 比较逐个对象的有理数运算与列式 RationalArray 的批量运算
+ *
+ * 100 万对小分数（分子 -50..50，分母是 60 的约数，点积的分母因此不超过 3600），
+ * 分别计算逐元素乘法、逐元素加法和点积：
+ * - RationalNonMember：tutorial_24 的写法，std::vector<RationalNonMember>，非成员 operator*
+ *   （加法按同样的写法补上），结果不约分；点积一直累加不约分的分数，很快就会溢出，只统计溢出的位置
+ * - Rational64：同样逐个对象运算，但结果约分并检查溢出（rational.h）
+ * - RationalArray：分子、分母分列存放，批量约分（rational_array.h）
+ * RationalArray 与 Rational64 的结果必须完全相同。
+ *
+ * 编译运行：clang++ -std=c++17 -O2 -march=native bench_rational_array.cpp -o bench && ./bench
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../tutorials/rational_array.h"
+
+constexpr size_t kCount  = 1'000'000;
+constexpr int    kRounds = 5;
+
+// 与 tutorial_24 相同：分子、分母为 int，运算结果不约分
+class RationalNonMember {
+  public:
+  RationalNonMember(int numerator = 0, int denominator = 1)
+    : num_(numerator)
+    , den_(denominator) {
+    if (denominator == 0)
+      throw std::invalid_argument("Denominator cannot be zero");
+  }
+
+  [[nodiscard]] auto numerator() const -> int { return num_; }
+  [[nodiscard]] auto denominator() const -> int { return den_; }
+
+  private:
+  int num_;
+  int den_;
+};
+
+auto operator*(const RationalNonMember& lhs, const RationalNonMember& rhs)
+  -> const RationalNonMember {
+  return RationalNonMember(
+    lhs.numerator() * rhs.numerator(), lhs.denominator() * rhs.denominator());
+}
+
+auto operator+(const RationalNonMember& lhs, const RationalNonMember& rhs)
+  -> const RationalNonMember {
+  return RationalNonMember(
+    lhs.numerator() * rhs.denominator() + rhs.numerator() * lhs.denominator(),
+    lhs.denominator() * rhs.denominator());
+}
+
+template<typename F> auto measure(F&& f) -> double {
+  double best = 1e300;
+  for (int round = 0; round < kRounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto   stop = std::chrono::steady_clock::now();
+    const double ns   = std::chrono::duration<double, std::nano>(stop - start).count() / kCount;
+    best              = ns < best ? ns : best;
+  }
+  return best;
+}
+
+// 不约分的点积在第几项溢出 int（用带检查的运算，避免未定义行为）
+auto unreducedDotOverflowStep(const std::vector<RationalNonMember>& a,
+                              const std::vector<RationalNonMember>& b) -> size_t {
+  int num = 0;
+  int den = 1;
+  for (size_t i = 0; i < a.size(); ++i) {
+    int pn = 0;
+    int pd = 0;
+    int lhs = 0;
+    int rhs = 0;
+    if (__builtin_mul_overflow(a[i].numerator(), b[i].numerator(), &pn) ||
+        __builtin_mul_overflow(a[i].denominator(), b[i].denominator(), &pd) ||
+        __builtin_mul_overflow(num, pd, &lhs) || __builtin_mul_overflow(pn, den, &rhs) ||
+        __builtin_add_overflow(lhs, rhs, &num) || __builtin_mul_overflow(den, pd, &den)) {
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+auto main() -> int {
+  static constexpr int32_t kDenominators[] = {1, 2, 3, 4, 5, 6, 10, 12, 15, 20, 30, 60};
+  std::mt19937                           rng(42);
+  std::uniform_int_distribution<int32_t> numerator(-50, 50);
+  std::uniform_int_distribution<size_t>  pick(0, std::size(kDenominators) - 1);
+  const auto                             denominator = [&] { return kDenominators[pick(rng)]; };
+
+  std::vector<RationalNonMember> objectsA;
+  std::vector<RationalNonMember> objectsB;
+  std::vector<Rational64>        reducedA;
+  std::vector<Rational64>        reducedB;
+  RationalArray                  columnsA;
+  RationalArray                  columnsB;
+  for (size_t i = 0; i < kCount; ++i) {
+    const int32_t an = numerator(rng);
+    const int32_t ad = denominator();
+    const int32_t bn = numerator(rng);
+    const int32_t bd = denominator();
+    columnsA.push_back(an, ad);
+    columnsB.push_back(bn, bd);
+    // 三种表示使用相同的（已约分的）输入
+    objectsA.emplace_back(columnsA.numerator(i), columnsA.denominator(i));
+    objectsB.emplace_back(columnsB.numerator(i), columnsB.denominator(i));
+    reducedA.push_back(columnsA.at(i));
+    reducedB.push_back(columnsB.at(i));
+  }
+
+  std::vector<RationalNonMember> objectsOut(kCount);
+  std::vector<Rational64>        reducedOut(kCount);
+  RationalArray                  columnsOut;
+  Rational64                     reducedDot;
+  Rational64                     columnsDot;
+
+  std::printf("%-30s %10s %10s %10s   (ns/element)\n", "implementation", "multiply", "add", "dot");
+
+  const double objectsMul = measure([&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      objectsOut[i] = objectsA[i] * objectsB[i];
+    }
+  });
+  const double objectsAdd = measure([&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      objectsOut[i] = objectsA[i] + objectsB[i];
+    }
+  });
+  std::printf(
+    "%-30s %10.2f %10.2f %10s\n", "RationalNonMember (unreduced)", objectsMul, objectsAdd, "-");
+
+  bool         same       = true;
+  const double reducedMul = measure([&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      reducedOut[i] = reducedA[i] * reducedB[i];
+    }
+  });
+  RationalArray::multiply(columnsA, columnsB, columnsOut);
+  for (size_t i = 0; i < kCount; ++i) {
+    same = same && columnsOut.at(i) == reducedOut[i];
+  }
+  const double reducedAdd = measure([&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      reducedOut[i] = reducedA[i] + reducedB[i];
+    }
+  });
+  RationalArray::add(columnsA, columnsB, columnsOut);
+  for (size_t i = 0; i < kCount; ++i) {
+    same = same && columnsOut.at(i) == reducedOut[i];
+  }
+  const double reducedDotNs = measure([&] {
+    reducedDot = 0;
+    for (size_t i = 0; i < kCount; ++i) {
+      reducedDot += reducedA[i] * reducedB[i];
+    }
+  });
+  std::printf(
+    "%-30s %10.2f %10.2f %10.2f\n", "Rational64 loop", reducedMul, reducedAdd, reducedDotNs);
+
+  const double columnsMul =
+    measure([&] { RationalArray::multiply(columnsA, columnsB, columnsOut); });
+  const double columnsAdd = measure([&] { RationalArray::add(columnsA, columnsB, columnsOut); });
+  const double columnsDotNs =
+    measure([&] { columnsDot = RationalArray::dot(columnsA, columnsB); });
+  std::printf(
+    "%-30s %10.2f %10.2f %10.2f\n", "RationalArray", columnsMul, columnsAdd, columnsDotNs);
+
+  same = same && columnsDot == reducedDot;
+  std::printf("\nunreduced dot product overflows int at element %zu\n",
+              unreducedDotOverflowStep(objectsA, objectsB));
+  std::printf("dot = %lld/%lld, RationalArray matches Rational64: %s\n",
+              static_cast<long long>(columnsDot.numerator()),
+              static_cast<long long>(columnsDot.denominator()),
+              same ? "yes" : "NO");
+  return same ? 0 : 1;
+}
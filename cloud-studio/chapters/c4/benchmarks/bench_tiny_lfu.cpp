@@ -0,0 +1,141 @@
+/**
+ * @file bench_tiny_lfu.cpp
+ * @brief 三种合成访问序列上，LRU（PageCache）与 W-TinyLFU（TinyLfuPageCache）的命中率和吞吐量
+ *
+ * 访问序列（未命中时把页面放进缓存，页面 64～1024 字节）：
+ * 1. zipf：10 万个 URL，200 万次 Zipf(0.99) 分布的访问
+ * 2. zipf + crawl：同样的热门流量，但每两次访问之间插入一个只访问一次的新 URL（爬虫流量）
+ * 3. loop：按顺序反复扫描 2 万个 URL，缓存只放得下其中一部分；LRU 每次都恰好淘汰下一个要访问的页面
+ * 预算按热门 URL（前两种）或循环中的 URL（第三种）全部页面大小的百分比计算。
+ *
+ * 编译运行：clang++ -std=c++17 -O2 bench_tiny_lfu.cpp -o bench && ./bench
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../tutorials/tiny_lfu_cache.h"
+
+constexpr size_t kHotUrls  = 100'000;
+constexpr size_t kRequests = 2'000'000;
+constexpr size_t kLoopUrls = 20'000;
+
+struct Trace {
+  const char*              name;
+  std::vector<std::string> urls;
+  std::vector<std::string> bodies;
+  std::vector<uint32_t>    requests;
+  size_t                   budgetBase = 0;   // 预算百分比的基数（字节）
+};
+
+auto makePages(Trace& trace, size_t count, std::mt19937_64& rng) -> size_t {
+  std::uniform_int_distribution<size_t> pageSize(64, 1024);
+  size_t                                bytes = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const size_t id = trace.urls.size();
+    trace.urls.push_back("https://site-" + std::to_string(id % 977) + ".example.com/page/" +
+                         std::to_string(id));
+    trace.bodies.emplace_back(pageSize(rng), 'x');
+    bytes += page_cache_detail::chargeOf(trace.urls.back(), trace.bodies.back());
+  }
+  return bytes;
+}
+
+// 按累积分布函数二分查找；排名打乱后再映射到 URL
+auto zipfRequests(size_t universe, size_t count, double skew, std::mt19937_64& rng)
+  -> std::vector<uint32_t> {
+  std::vector<double> cdf(universe);
+  double              sum = 0;
+  for (size_t rank = 0; rank < universe; ++rank) {
+    sum += 1.0 / std::pow(static_cast<double>(rank + 1), skew);
+    cdf[rank] = sum;
+  }
+  std::vector<uint32_t> id(universe);
+  for (size_t i = 0; i < universe; ++i) {
+    id[i] = static_cast<uint32_t>(i);
+  }
+  std::shuffle(id.begin(), id.end(), rng);
+
+  std::uniform_real_distribution<double> uniform(0.0, sum);
+  std::vector<uint32_t>                  requests(count);
+  for (auto& request : requests) {
+    const size_t rank = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+    request           = id[std::min(rank, universe - 1)];
+  }
+  return requests;
+}
+
+auto zipfTrace(std::mt19937_64& rng) -> Trace {
+  Trace trace{"zipf", {}, {}, {}, 0};
+  trace.budgetBase = makePages(trace, kHotUrls, rng);
+  trace.requests   = zipfRequests(kHotUrls, kRequests, 0.99, rng);
+  return trace;
+}
+
+auto crawlTrace(std::mt19937_64& rng) -> Trace {
+  Trace trace{"zipf + crawl", {}, {}, {}, 0};
+  trace.budgetBase = makePages(trace, kHotUrls, rng);
+  makePages(trace, kRequests / 2, rng);
+  const auto hot = zipfRequests(kHotUrls, kRequests / 2, 0.99, rng);
+  for (size_t i = 0; i < hot.size(); ++i) {
+    trace.requests.push_back(hot[i]);
+    trace.requests.push_back(static_cast<uint32_t>(kHotUrls + i));
+  }
+  return trace;
+}
+
+auto loopTrace(std::mt19937_64& rng) -> Trace {
+  Trace trace{"loop", {}, {}, {}, 0};
+  trace.budgetBase = makePages(trace, kLoopUrls, rng);
+  for (size_t i = 0; i < kRequests; ++i) {
+    trace.requests.push_back(static_cast<uint32_t>(i % kLoopUrls));
+  }
+  return trace;
+}
+
+// 回放访问序列，返回每秒百万次访问
+template<typename Cache> auto replay(Cache& cache, const Trace& trace) -> double {
+  const auto start = std::chrono::steady_clock::now();
+  for (const uint32_t id : trace.requests) {
+    if (cache.get(trace.urls[id]) == nullptr) {
+      cache.put(trace.urls[id], trace.bodies[id]);
+    }
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return static_cast<double>(trace.requests.size()) /
+         std::chrono::duration<double, std::micro>(stop - start).count();
+}
+
+void run(const Trace& trace) {
+  std::printf("%s (%zu requests)\n", trace.name, trace.requests.size());
+  std::printf("   %8s %22s %22s\n", "budget", "LRU hit% / Mops/s", "W-TinyLFU hit% / Mops/s");
+  for (const double fraction : {0.01, 0.05, 0.20, 0.50}) {
+    const auto budget = static_cast<size_t>(static_cast<double>(trace.budgetBase) * fraction);
+
+    PageCache        lru(budget);
+    const double     lruOps = replay(lru, trace);
+    TinyLfuPageCache tinyLfu(budget);
+    const double     tinyLfuOps = replay(tinyLfu, trace);
+    std::printf("   %7.0f%% %13.1f%% %7.2f %13.1f%% %7.2f\n",
+                fraction * 100,
+                lru.stats().hitRate() * 100,
+                lruOps,
+                tinyLfu.stats().hitRate() * 100,
+                tinyLfuOps);
+  }
+  std::printf("\n");
+}
+
+auto main() -> int {
+  std::mt19937_64 rng(42);
+  run(zipfTrace(rng));
+  run(crawlTrace(rng));
+  run(loopTrace(rng));
+  return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file bench_units.cpp
+ * @brief 验证 units::Quantity 相对裸 double 没有额外开销，并与运行时按单位标记换算的写法比较
+ *
+ * 1000 万个英里读数换算成千米、再求和：
+ * - raw double：手写 out[i] = in[i] * 1.609344
+ * - units：units::convert<Kilometers>(miles, km, n)，系数由 std::ratio 在编译期折叠
+ * - runtime tag：每个读数带一个单位枚举，逐个 switch 后除以每千米的米数（遥测代码原来的写法）
+ * raw double 与 units 的结果逐位相同、耗时相同；两个核心循环 rawKernel / unitsKernel 生成的代码
+ * 可以用 clang++ -std=c++17 -O2 -S bench_units.cpp 对比。
+ *
+ * 编译运行：clang++ -std=c++17 -O2 bench_units.cpp -o bench && ./bench
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "../tutorials/units.h"
+
+constexpr size_t kCount  = 10'000'000;
+constexpr int    kRounds = 10;
+
+static volatile double sink;
+
+using units::Kilometers;
+using units::Miles;
+
+// 编译期就能算出的换算
+static_assert(units::quantity_cast<units::Meters>(Kilometers(1.5)).count() == 1500.0);
+static_assert(Kilometers(1.0) < Miles(1.0));
+
+enum class LengthUnit : uint8_t
+{
+  Meter,
+  Kilometer,
+  Mile,
+};
+
+struct TaggedReading {
+  double     value;
+  LengthUnit unit;
+};
+
+__attribute__((noinline)) void rawKernel(const double* in, double* out, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = in[i] * 1.609344;
+  }
+}
+
+__attribute__((noinline)) void unitsKernel(const Miles* in, Kilometers* out, size_t count) {
+  units::convert<Kilometers>(in, out, count);
+}
+
+__attribute__((noinline)) void taggedKernel(const TaggedReading* in, double* out, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    double meters = 0;
+    switch (in[i].unit) {
+    case LengthUnit::Meter:
+      meters = in[i].value;
+      break;
+    case LengthUnit::Kilometer:
+      meters = in[i].value * 1000.0;
+      break;
+    case LengthUnit::Mile:
+      meters = in[i].value * 1609.344;
+      break;
+    }
+    out[i] = meters / 1000.0;
+  }
+}
+
+template<typename F> auto measure(F&& f) -> double {
+  double best = 1e300;
+  for (int round = 0; round < kRounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto   stop = std::chrono::steady_clock::now();
+    const double ns   = std::chrono::duration<double, std::nano>(stop - start).count() / kCount;
+    best              = ns < best ? ns : best;
+  }
+  return best;
+}
+
+auto main() -> int {
+  std::vector<double>        raw(kCount);
+  std::vector<Miles>         miles(kCount);
+  std::vector<TaggedReading> tagged(kCount);
+  uint64_t                   state = 42;
+  for (size_t i = 0; i < kCount; ++i) {
+    state              = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    const double value = static_cast<double>(state >> 40) / 1e3;
+    raw[i]             = value;
+    miles[i]           = Miles(value);
+    tagged[i]          = {value, LengthUnit::Mile};
+  }
+
+  std::vector<double>     rawOut(kCount);
+  std::vector<Kilometers> unitsOut(kCount);
+  std::vector<double>     taggedOut(kCount);
+
+  std::printf("%-22s %12s %12s\n", "kernel", "convert ns", "sum ns");
+  const double rawConvert = measure([&] { rawKernel(raw.data(), rawOut.data(), kCount); });
+  const double rawSum     = measure([&] {
+    double total = 0;
+    for (double km : rawOut) {
+      total += km;
+    }
+    sink = total;
+  });
+  std::printf("%-22s %12.3f %12.3f\n", "raw double", rawConvert, rawSum);
+
+  const double unitsConvert = measure([&] { unitsKernel(miles.data(), unitsOut.data(), kCount); });
+  const double unitsSum     = measure([&] { sink = units::sum(unitsOut.data(), kCount).count(); });
+  std::printf("%-22s %12.3f %12.3f\n", "units::Quantity", unitsConvert, unitsSum);
+
+  const double taggedConvert =
+    measure([&] { taggedKernel(tagged.data(), taggedOut.data(), kCount); });
+  std::printf("%-22s %12.3f %12s\n", "runtime unit tag", taggedConvert, "-");
+
+  // Quantity 数组就是 double 数组：两种写法的结果必须逐位相同
+  const bool identical = std::memcmp(rawOut.data(), unitsOut.data(), kCount * sizeof(double)) == 0;
+  std::printf("\nunits output bit-identical to raw double: %s\n", identical ? "yes" : "NO");
+  return identical ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <c4/tutorials/account_ledger.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+TEST(AccountLedgerTest, DepositOverflowLeavesBalanceUnchanged) {
+  AccountLedger ledger(16, 4, 1);
+  EXPECT_EQ(ledger.apply(Transaction::deposit(3, INT64_MAX - 10)), AccountStatus::Ok);
+  EXPECT_EQ(ledger.apply(Transaction::deposit(3, 11)), AccountStatus::Overflow);
+  EXPECT_EQ(ledger.balance(3), INT64_MAX - 10);
+}
+
+TEST(AccountLedgerTest, TransferOverflowLeavesBothBalancesUnchanged) {
+  AccountLedger ledger(16, 4, 1);
+  ASSERT_EQ(ledger.apply(Transaction::deposit(0, 100)), AccountStatus::Ok);
+  ASSERT_EQ(ledger.apply(Transaction::deposit(1, INT64_MAX)), AccountStatus::Ok);    // 同一分片
+  ASSERT_EQ(ledger.apply(Transaction::deposit(12, INT64_MAX)), AccountStatus::Ok);   // 另一分片
+
+  EXPECT_EQ(ledger.apply(Transaction::transfer(0, 1, 1)), AccountStatus::Overflow);
+  EXPECT_EQ(ledger.apply(Transaction::transfer(0, 12, 1)), AccountStatus::Overflow);
+  EXPECT_EQ(ledger.balance(0), 100);
+  EXPECT_EQ(ledger.balance(1), INT64_MAX);
+  EXPECT_EQ(ledger.balance(12), INT64_MAX);
+
+  // 转给自己不会溢出
+  EXPECT_EQ(ledger.apply(Transaction::transfer(1, 1, 5)), AccountStatus::Ok);
+  EXPECT_EQ(ledger.balance(1), INT64_MAX);
+}
+
+TEST(AccountLedgerTest, BatchReportsOverflow) {
+  AccountLedger            ledger(16, 4, 1);
+  std::vector<Transaction> batch = {
+    Transaction::deposit(5, INT64_MAX),
+    Transaction::deposit(5, INT64_MAX),
+    Transaction::deposit(6, 7),
+  };
+  std::vector<AccountStatus> results(batch.size());
+  EXPECT_EQ(ledger.apply(batch, results.data()), 2u);
+  EXPECT_EQ(results[1], AccountStatus::Overflow);
+  EXPECT_EQ(ledger.balance(5), INT64_MAX);
+  EXPECT_EQ(ledger.balance(6), 7);
+
+  // 足够大的批次走多线程分桶路径
+  AccountLedger            parallel(16, 4, 2);
+  const int64_t            amount = INT64_MAX / 10'000;
+  std::vector<Transaction> deposits(20'000, Transaction::deposit(9, amount));
+  EXPECT_EQ(parallel.apply(deposits), 10'000u);
+  EXPECT_EQ(parallel.balance(9), amount * 10'000);
+}
+
+TEST(AccountLedgerTest, UnknownAccount) {
+  AccountLedger ledger(16, 4, 1);
+  EXPECT_EQ(ledger.apply(Transaction::deposit(16, 1)), AccountStatus::UnknownAccount);
+  EXPECT_THROW((void)ledger.balance(16), std::out_of_range);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <c4/tutorials/counted_rational.h>
+
+#include <utility>
+#include <vector>
+
+class LifecycleCounterTest : public testing::Test {
+protected:
+  void SetUp() override {
+    if (!kLifecycleCountersEnabled) {
+      GTEST_SKIP() << "built with LIFECYCLE_COUNTERS=0";
+    }
+  }
+};
+
+TEST_F(LifecycleCounterTest, MultiplyConstructsExactlyOnce) {
+  const Rational a(1, 2);
+  const Rational b(3, 4);
+
+  LifecycleScope<Rational> scope;
+  {
+    [[maybe_unused]] const Rational c = a * b;   // 返回值直接构造在 c 中
+    const LifecycleCounts counts = scope.diff();
+    EXPECT_EQ(counts.constructed, 1u);
+    EXPECT_EQ(counts.copied, 0u);
+    EXPECT_EQ(counts.moved, 0u);
+    EXPECT_EQ(counts.destroyed, 0u);
+  }
+  EXPECT_EQ(scope.diff().destroyed, 1u);
+  EXPECT_EQ(scope.diff().live(), 0);
+}
+
+TEST_F(LifecycleCounterTest, ImplicitConversionCreatesTemporary) {
+  const Rational half(1, 2);
+
+  LifecycleScope<Rational> scope;
+  [[maybe_unused]] const Rational result = half * 2;   // 2 先转换成临时的 Rational
+  const LifecycleCounts counts = scope.diff();
+  EXPECT_EQ(counts.constructed, 2u);
+  EXPECT_EQ(counts.destroyed, 1u);
+  EXPECT_EQ(counts.live(), 1);
+}
+
+TEST_F(LifecycleCounterTest, CountsCopiesAndMoves) {
+  LifecycleScope<Rational> scope;
+  Rational original(1, 3);
+  Rational copy = original;
+  Rational moved = std::move(copy);
+  copy = moved;   // 赋值不创建对象
+
+  EXPECT_EQ(scope.diff(), (LifecycleCounts{1, 1, 1, 0}));
+}
+
+TEST_F(LifecycleCounterTest, ScopesAreIndependentPerType) {
+  struct Other : private LifecycleCounted<Other> {};
+
+  LifecycleScope<Rational> rationals;
+  LifecycleScope<Other> others;
+  {
+    std::vector<Other> items(3);
+  }
+  EXPECT_EQ(rationals.diff(), LifecycleCounts{});
+  EXPECT_EQ(others.diff().constructed, 3u);
+  EXPECT_EQ(others.diff().live(), 0);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <c4/tutorials/page_cache.h>
+
+#include <string>
+
+class PageCacheTest : public testing::Test {
+protected:
+  // 每个页面的占用是 URL + 内容 + 固定开销；预算刚好放下三个 "/a" 这样的页面
+  static constexpr size_t kBody   = 100;
+  static constexpr size_t kCharge = 2 + kBody + page_cache_detail::kEntryOverhead;
+
+  PageCache cache{3 * kCharge};
+
+  void put(const std::string& url) { cache.put(url, std::string(kBody, 'x')); }
+};
+
+TEST_F(PageCacheTest, EvictsLeastRecentlyUsedWhenOverBudget) {
+  put("/a");
+  put("/b");
+  put("/c");
+  EXPECT_NE(cache.get("/a"), nullptr);   // /a 变成最近使用，/b 成为最久未使用
+  put("/d");
+
+  EXPECT_FALSE(cache.contains("/b"));
+  EXPECT_TRUE(cache.contains("/a"));
+  EXPECT_TRUE(cache.contains("/c"));
+  EXPECT_TRUE(cache.contains("/d"));
+  EXPECT_EQ(cache.size(), 3u);
+  EXPECT_EQ(cache.bytes(), 3 * kCharge);
+  EXPECT_EQ(cache.stats().evictions, 1u);
+}
+
+TEST_F(PageCacheTest, CountsHitsAndMisses) {
+  put("/a");
+  EXPECT_EQ(*cache.get("/a"), std::string(kBody, 'x'));
+  EXPECT_EQ(cache.get("/missing"), nullptr);
+  EXPECT_EQ(cache.stats().hits, 1u);
+  EXPECT_EQ(cache.stats().misses, 1u);
+  EXPECT_DOUBLE_EQ(cache.stats().hitRate(), 0.5);
+}
+
+TEST_F(PageCacheTest, ReplacingPageUpdatesCharge) {
+  put("/a");
+  put("/b");
+  cache.put("/a", std::string(kBody + 2 * kCharge, 'y'));   // 变大后需要淘汰 /b
+
+  EXPECT_FALSE(cache.contains("/b"));
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.bytes(), 3 * kCharge);
+  EXPECT_EQ(cache.get("/a")->size(), kBody + 2 * kCharge);
+}
+
+TEST_F(PageCacheTest, RejectsPageLargerThanBudget) {
+  put("/a");
+  EXPECT_FALSE(cache.put("/a", std::string(3 * kCharge, 'x')));
+  EXPECT_FALSE(cache.contains("/a"));   // 旧内容也删除
+  EXPECT_EQ(cache.bytes(), 0u);
+  EXPECT_EQ(cache.stats().rejections, 1u);
+}
+
+TEST_F(PageCacheTest, ClearKeepsStatsAndAcceptsNewPages) {
+  put("/a");
+  put("/b");
+  cache.get("/a");
+  cache.clear();
+
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.bytes(), 0u);
+  EXPECT_FALSE(cache.contains("/a"));
+  EXPECT_EQ(cache.stats().hits, 1u);
+
+  put("/c");
+  EXPECT_TRUE(cache.contains("/c"));
+  EXPECT_EQ(cache.bytes(), kCharge);
+}
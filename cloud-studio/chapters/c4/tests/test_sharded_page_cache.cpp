@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <c4/tutorials/sharded_page_cache.h>
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ShardedPageCacheTest, RoundsShardCountUpToPowerOfTwo) {
+  EXPECT_EQ(ShardedPageCache(1 << 20, 1).shardCount(), 1u);
+  EXPECT_EQ(ShardedPageCache(1 << 20, 5).shardCount(), 8u);
+  EXPECT_EQ(ShardedPageCache(1 << 20).shardCount(), ShardedPageCache::kDefaultShards);
+}
+
+TEST(ShardedPageCacheTest, GetReturnsCopy) {
+  ShardedPageCache cache(1 << 20, 4);
+  EXPECT_TRUE(cache.put("/a", "hello"));
+  EXPECT_EQ(cache.get("/a"), std::optional<std::string>("hello"));
+  EXPECT_EQ(cache.get("/b"), std::nullopt);
+  EXPECT_TRUE(cache.erase("/a"));
+  EXPECT_FALSE(cache.visit("/a", [](const std::string&) {}));
+
+  const CacheStats stats = cache.stats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 2u);
+}
+
+TEST(ShardedPageCacheTest, ConcurrentBrowsingAndClear) {
+  constexpr int    kThreads = 8;
+  constexpr int    kOps     = 5'000;
+  ShardedPageCache cache(64 * 1024, 16);
+
+  std::atomic<bool>        stop{false};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < kThreads; ++t) {
+    workers.emplace_back([&cache, t] {
+      for (int i = 0; i < kOps; ++i) {
+        const std::string url = "/" + std::to_string((i * 31 + t) % 500);
+        if (!cache.visit(url, [](const std::string&) {})) {
+          cache.put(url, std::string(100, 'x'));
+        }
+      }
+    });
+  }
+  std::thread cleaner([&cache, &stop] {
+    while (!stop.load()) {
+      cache.clear();
+      std::this_thread::yield();
+    }
+  });
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  stop = true;
+  cleaner.join();
+
+  EXPECT_EQ(cache.stats().lookups(), static_cast<uint64_t>(kThreads) * kOps);
+  EXPECT_LE(cache.bytes(), cache.budget());
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <c4/tutorials/tiny_lfu_cache.h>
+
+#include <string>
+
+TEST(FrequencySketchTest, EstimatesAndAges) {
+  FrequencySketch sketch(1024);
+  for (int i = 0; i < 5; ++i) {
+    sketch.increment(42);
+  }
+  EXPECT_GE(sketch.estimate(42), 5u);   // 只会高估
+  EXPECT_EQ(sketch.estimate(7), 0u);
+
+  for (int i = 0; i < 100; ++i) {
+    sketch.increment(42);
+  }
+  EXPECT_EQ(sketch.estimate(42), 15u);   // 饱和
+
+  sketch.age();
+  EXPECT_EQ(sketch.estimate(42), 7u);
+}
+
+class TinyLfuPageCacheTest : public testing::Test {
+protected:
+  static constexpr size_t kBody   = 1000;
+  static constexpr size_t kCharge = 5 + kBody + page_cache_detail::kEntryOverhead;
+
+  // 主区放得下 10 个页面，窗口放不下一个页面：新页面立即参加准入比较
+  TinyLfuPageCache cache{10 * kCharge + 10 * kCharge / 99};
+
+  void browse(const std::string& url) {
+    if (cache.get(url) == nullptr) {
+      cache.put(url, std::string(kBody, 'x'));
+    }
+  }
+
+  static auto url(int i) -> std::string { return "/" + std::to_string(1000 + i); }
+};
+
+TEST_F(TinyLfuPageCacheTest, ScanDoesNotFlushHotPages) {
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 8; ++i) {
+      browse(url(i));
+    }
+  }
+  // 一次性访问的扫描：每个新 URL 只访问一次，频率低于热门页面，准入时被拒绝
+  for (int i = 100; i < 1100; ++i) {
+    browse(url(i));
+  }
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(cache.contains(url(i))) << url(i);
+  }
+  EXPECT_LE(cache.bytes(), cache.budget());
+}
+
+TEST_F(TinyLfuPageCacheTest, FrequentNewcomerIsAdmitted) {
+  for (int i = 0; i < 10; ++i) {
+    browse(url(i));
+  }
+  for (int round = 0; round < 3; ++round) {
+    cache.get(url(50));   // 未命中也计入频率
+  }
+  browse(url(50));
+  EXPECT_TRUE(cache.contains(url(50)));
+  EXPECT_EQ(cache.size(), 10u);
+  EXPECT_EQ(cache.stats().evictions, 1u);
+}
+
+TEST_F(TinyLfuPageCacheTest, ClearForgetsFrequencies) {
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 10; ++i) {
+      browse(url(i));
+    }
+  }
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.bytes(), 0u);
+
+  // 频率已经清零：新页面与旧页面处于同一起点，主区有空间就直接进入
+  for (int i = 100; i < 110; ++i) {
+    browse(url(i));
+  }
+  EXPECT_EQ(cache.size(), 10u);
+}
+
+TEST(TinyLfuPageCacheShrinkTest, ShrinkBelowWindowPage) {
+  TinyLfuPageCache cache(1'000'000);
+  EXPECT_TRUE(cache.put("a", std::string(5000, 'x')));
+
+  // 窗口中的页面比缩小后的整个主区还大：直接淘汰
+  cache.setBudget(4000);
+  EXPECT_FALSE(cache.contains("a"));
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.bytes(), 0u);
+  EXPECT_EQ(cache.stats().evictions, 1u);
+}
@@ -0,0 +1,332 @@
+#ifndef __ACCOUNT_JOURNAL__H
+#define __ACCOUNT_JOURNAL__H
+
+/**
+ * @file account_journal.h
+ * @brief 账户余额的写前日志（仅限 Linux / POSIX）
+ *
+ * BankAccount 修改余额之前先调用 record(owner, newBalance) 追加一条记录，
+ * 记录“写好”（按 Durability 的定义）之后才真正修改内存中的余额。进程重启后
+ * replay() / recoverBalances() 按顺序重放日志，每个账户最后一条记录就是它的余额。
+ *
+ * 记录格式（本机字节序）：
+ *   uint32 crc32 | uint32 length | uint64 sequence | int64 balance（分） | owner（length - 16 字节）
+ * crc32 覆盖 sequence 之后的全部内容。崩溃时最后一条记录可能只写了一半，
+ * 重放遇到长度不完整或校验失败的记录就停止，并把文件截断到最后一条完整记录之后。
+ *
+ * 组提交：GroupSync 级别下，多个线程同时 record() 时只有一个线程（leader）执行
+ * write + fdatasync，它把到那时为止所有线程追加的记录一起落盘；其余线程等待
+ * 自己的记录被某次 fdatasync 覆盖后返回。并发越高，每次 fdatasync 分摊的记录越多。
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+#include "money.h"
+
+enum class Durability
+{
+  Buffered,    // 只写进进程内缓冲区，攒满 64 KB 或 flush() 时才 write；进程崩溃会丢失缓冲区
+  Written,     // 每条记录都 write 到内核，进程崩溃不丢，断电可能丢
+  GroupSync,   // write + fdatasync，并发的记录共享一次 fdatasync（组提交）
+  Sync,        // 每条记录单独 write + fdatasync，不合并
+};
+
+class AccountJournal {
+  public:
+  AccountJournal(const std::string& path, Durability durability)
+    : durability_(durability) {
+    fd_ = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+  }
+
+  // 析构时把缓冲区中剩余的记录写出并落盘；失败只能忽略，需要确认的调用方应先调用 flush()
+  ~AccountJournal() {
+    flush();
+    ::close(fd_);
+  }
+
+  AccountJournal(const AccountJournal&)                    = delete;
+  auto operator=(const AccountJournal&) -> AccountJournal& = delete;
+
+  /**
+   * 追加一条“owner 的余额变为 balance”的记录，按 Durability 等到记录写好后返回
+   * 返回非空的 error_code 表示写入失败；失败后日志不再接受新记录（之后的调用都返回同一个错误）
+   */
+  auto record(std::string_view owner, Money balance) noexcept -> std::error_code {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (error_) {
+      return error_;
+    }
+    uint64_t sequence = 0;
+    try {
+      sequence = ++appended_;
+      encode(pending_, sequence, owner, balance);
+    } catch (const std::bad_alloc&) {
+      return fail(std::make_error_code(std::errc::not_enough_memory));
+    }
+    ++records_;
+
+    switch (durability_) {
+    case Durability::Buffered:
+      if (pending_.size() < kBufferBytes) {
+        return {};
+      }
+      return fail(writeAll(takePending()));
+    case Durability::Written:
+      return fail(writeAll(takePending()));
+    case Durability::Sync:
+      // 持有锁完成 write + fdatasync，其他线程只能排队，每条记录各自落盘
+      if (std::error_code ec = writeAll(takePending()); ec) {
+        return fail(ec);
+      }
+      return fail(sync());
+    case Durability::GroupSync:
+      return waitDurable(lock, sequence);
+    }
+    return {};
+  }
+
+  // 写出缓冲区中的所有记录并 fdatasync，与 Durability 无关
+  auto flush() noexcept -> std::error_code {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (error_) {
+      return error_;
+    }
+    // 等待正在进行的组提交结束，保证它的记录排在本次写入之前
+    durableChanged_.wait(lock, [this] { return !syncing_; });
+    if (std::error_code ec = writeAll(takePending()); ec) {
+      return fail(ec);
+    }
+    if (std::error_code ec = sync(); ec) {
+      return fail(ec);
+    }
+    durable_ = appended_;
+    return {};
+  }
+
+  // 已追加的记录数和执行过的 fdatasync 次数，两者之比就是组提交的平均批量
+  [[nodiscard]] auto records() const -> uint64_t {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_;
+  }
+  [[nodiscard]] auto syncs() const -> uint64_t {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return syncs_;
+  }
+
+  /**
+   * 按顺序把日志中每条完整的记录交给 apply(owner, balance)，返回记录条数
+   * 末尾不完整或校验失败的部分会被截断；文件不存在时返回 0
+   */
+  template<typename F> static auto replay(const std::string& path, F&& apply) -> size_t {
+    const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+      if (errno == ENOENT) {
+        return 0;
+      }
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    std::string contents;
+    char        chunk[64 * 1024];
+    for (;;) {
+      const ssize_t got = ::read(fd, chunk, sizeof(chunk));
+      if (got < 0 && errno == EINTR) {
+        continue;
+      }
+      if (got < 0) {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "read " + path);
+      }
+      if (got == 0) {
+        break;
+      }
+      contents.append(chunk, static_cast<size_t>(got));
+    }
+
+    size_t offset = 0;
+    size_t count  = 0;
+    while (contents.size() - offset >= kHeaderBytes) {
+      uint32_t crc    = 0;
+      uint32_t length = 0;
+      std::memcpy(&crc, contents.data() + offset, sizeof(crc));
+      std::memcpy(&length, contents.data() + offset + 4, sizeof(length));
+      const size_t body = offset + 8;
+      if (length < kFixedBodyBytes || contents.size() - body < length ||
+          crc32(contents.data() + body, length) != crc) {
+        break;   // 写了一半的记录
+      }
+      int64_t balance = 0;
+      std::memcpy(&balance, contents.data() + body + 8, sizeof(balance));
+      const std::string_view owner(
+        contents.data() + body + kFixedBodyBytes, length - kFixedBodyBytes);
+      apply(owner, Money::fromMinor(balance));
+      offset = body + length;
+      ++count;
+    }
+    if (offset < contents.size() && ::ftruncate(fd, static_cast<off_t>(offset)) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "ftruncate " + path);
+    }
+    ::close(fd);
+    return count;
+  }
+
+  // 重放日志，得到每个账户最后记录的余额
+  static auto recoverBalances(const std::string& path) -> std::unordered_map<std::string, Money> {
+    std::unordered_map<std::string, Money> balances;
+    replay(path, [&balances](std::string_view owner, Money balance) {
+      balances[std::string(owner)] = balance;
+    });
+    return balances;
+  }
+
+  private:
+  static constexpr size_t kBufferBytes    = 64 * 1024;
+  static constexpr size_t kHeaderBytes    = 8;    // crc32 + length
+  static constexpr size_t kFixedBodyBytes = 16;   // sequence + balance
+
+  const Durability        durability_;
+  int                     fd_ = -1;
+  mutable std::mutex      mutex_;
+  std::condition_variable durableChanged_;
+  std::string             pending_;            // 已追加、尚未 write 的记录
+  std::string             spare_;              // 与 pending_ 交替使用，避免反复分配
+  uint64_t                appended_ = 0;       // 最后一条已追加记录的序号
+  uint64_t                durable_  = 0;       // 序号不超过它的记录都已 fdatasync
+  bool                    syncing_  = false;   // 是否有 leader 正在写盘
+  uint64_t                records_  = 0;
+  uint64_t                syncs_    = 0;
+  std::error_code         error_;
+
+  static auto crcTable() -> const std::array<uint32_t, 256>& {
+    static const std::array<uint32_t, 256> table = [] {
+      std::array<uint32_t, 256> t{};
+      for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+          c = (c & 1u) != 0 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        t[i] = c;
+      }
+      return t;
+    }();
+    return table;
+  }
+
+  static auto crc32(const char* data, size_t size) -> uint32_t {
+    const auto& table = crcTable();
+    uint32_t    c     = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+      c = table[(c ^ static_cast<uint8_t>(data[i])) & 0xFFu] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+  }
+
+  static void encode(std::string& out, uint64_t sequence, std::string_view owner, Money money) {
+    const int64_t balance = money.minor();
+    const auto   length = static_cast<uint32_t>(kFixedBodyBytes + owner.size());
+    const size_t start  = out.size();
+    out.resize(start + kHeaderBytes + length);
+    char* p = out.data() + start;
+    std::memcpy(p + 4, &length, sizeof(length));
+    std::memcpy(p + 8, &sequence, sizeof(sequence));
+    std::memcpy(p + 16, &balance, sizeof(balance));
+    std::memcpy(p + 24, owner.data(), owner.size());
+    const uint32_t crc = crc32(p + kHeaderBytes, length);
+    std::memcpy(p, &crc, sizeof(crc));
+  }
+
+  // 取走待写的记录，换上一块清空的备用缓冲区；返回的引用在下一次 takePending() 前有效
+  auto takePending() -> std::string& {
+    pending_.swap(spare_);
+    pending_.clear();
+    return spare_;
+  }
+
+  auto writeAll(const std::string& bytes) noexcept -> std::error_code {
+    size_t written = 0;
+    while (written < bytes.size()) {
+      const ssize_t n = ::write(fd_, bytes.data() + written, bytes.size() - written);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n < 0) {
+        return {errno, std::generic_category()};
+      }
+      written += static_cast<size_t>(n);
+    }
+    return {};
+  }
+
+  auto sync() noexcept -> std::error_code {
+    ++syncs_;
+    if (::fdatasync(fd_) != 0) {
+      return {errno, std::generic_category()};
+    }
+    return {};
+  }
+
+  auto fail(std::error_code ec) -> std::error_code {
+    if (ec) {
+      error_ = ec;
+      durableChanged_.notify_all();
+    }
+    return ec;
+  }
+
+  // 组提交：没有 leader 时自己当 leader，把目前所有待写的记录一次写盘；否则等待
+  auto waitDurable(std::unique_lock<std::mutex>& lock, uint64_t sequence) -> std::error_code {
+    while (durable_ < sequence) {
+      if (error_) {
+        return error_;
+      }
+      if (syncing_) {
+        durableChanged_.wait(lock);
+        continue;
+      }
+      syncing_                 = true;
+      std::string    batch     = std::move(pending_);
+      const uint64_t batchLast = appended_;
+      pending_                 = std::move(spare_);
+      pending_.clear();
+
+      // 写盘期间释放锁，其他线程可以继续追加记录，它们会进入下一批
+      lock.unlock();
+      std::error_code ec = writeAll(batch);
+      if (!ec && ::fdatasync(fd_) != 0) {
+        ec = {errno, std::generic_category()};
+      }
+      lock.lock();
+
+      ++syncs_;
+      syncing_ = false;
+      spare_   = std::move(batch);
+      if (ec) {
+        return fail(ec);
+      }
+      durable_ = batchLast;
+      durableChanged_.notify_all();
+    }
+    return {};
+  }
+};
+
+#endif
@@ -0,0 +1,362 @@
+#ifndef __ACCOUNT_LEDGER__H
+#define __ACCOUNT_LEDGER__H
+
+/**
+ * @file account_ledger.h
+ * @brief 按账户编号分片的账本，批量并行地应用交易
+ *
+ * 几百万个 BankAccount 对象各自带着 std::string 和 double，分散在堆上；
+ * AccountLedger 把所有余额（以分为单位）放在一个按账户编号索引的连续数组里，
+ * 并按编号区间切成若干分片，每个分片一把锁。
+ *
+ * apply(transactions, count, results) 分三步：
+ * 1. 计数排序：按分片把交易连同它的编号复制到各自的桶里（桶内保持原来的顺序），
+ *    跨分片的转账单独放一组；之后每个线程顺序读取自己的桶，不再跳着访问原数组
+ * 2. 多个线程各自领取分片，持有该分片的锁，按顺序应用桶里的交易
+ * 3. 跨分片转账：按分片编号从小到大同时锁住两个分片再转账，扣款和入账要么都发生，要么都不发生
+ *
+ * 同一分片内的交易按提交顺序生效；跨分片转账在同一批的分片内交易之后生效，
+ * 它们彼此之间的先后顺序不确定（与多个客户端同时提交相同）。
+ * 只用一个线程时（批次很小或 threads 为 1）不分桶：锁住所有分片后按提交顺序逐笔应用，
+ * 省掉分桶时复制交易的内存带宽。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "account_status.h"
+
+struct Transaction {
+  enum class Kind : uint8_t
+  {
+    Deposit,
+    Withdraw,
+    Transfer,
+  };
+
+  Kind     kind   = Kind::Deposit;
+  uint32_t from   = 0;   // 存款/取款的账户，转账的付款账户
+  uint32_t to     = 0;   // 转账的收款账户
+  int64_t  amount = 0;   // 分
+
+  static auto deposit(uint32_t account, int64_t amount) -> Transaction {
+    return {Kind::Deposit, account, account, amount};
+  }
+  static auto withdraw(uint32_t account, int64_t amount) -> Transaction {
+    return {Kind::Withdraw, account, account, amount};
+  }
+  static auto transfer(uint32_t from, uint32_t to, int64_t amount) -> Transaction {
+    return {Kind::Transfer, from, to, amount};
+  }
+};
+
+class AccountLedger {
+  public:
+  // threads 为 0 时使用硬件线程数
+  // 每个分片的账户数向上取整到 2 的幂，定位分片只需要一次移位（不用除法），
+  // 因此实际的分片数 shardCount() 可能比 shards 少
+  AccountLedger(size_t accounts, size_t shards, unsigned threads = 0)
+    : balances_(accounts, 0)
+    , shardShift_(shiftFor(accounts, shards))
+    , shardCount_((std::max<size_t>(accounts, 1) + shardSize() - 1) >> shardShift_)
+    , shards_(std::make_unique<Shard[]>(shardCount_))
+    , threads_(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+  AccountLedger(const AccountLedger&)                    = delete;
+  auto operator=(const AccountLedger&) -> AccountLedger& = delete;
+
+  [[nodiscard]] auto size() const -> size_t { return balances_.size(); }
+  [[nodiscard]] auto shardCount() const -> size_t { return shardCount_; }
+  [[nodiscard]] auto shardSize() const -> size_t { return size_t{1} << shardShift_; }
+
+  // 编号超出范围时抛出 std::out_of_range（与 apply() 返回 UnknownAccount 的情形相同）
+  [[nodiscard]] auto balance(uint32_t account) const -> int64_t {
+    if (account >= balances_.size()) {
+      throw std::out_of_range("AccountLedger: unknown account");
+    }
+    std::lock_guard<std::mutex> lock(shardOf(account).mutex);
+    return balances_[account];
+  }
+
+  // 按顺序锁住所有分片，得到一致的总额（转账前后总额不变）
+  [[nodiscard]] auto totalBalance() const -> int64_t {
+    const auto locks = lockAll();
+    int64_t    total = 0;
+    for (int64_t balance : balances_) {
+      total += balance;
+    }
+    return total;
+  }
+
+  // 单笔交易，与 apply() 可以并发调用
+  [[nodiscard]] auto apply(const Transaction& tx) -> AccountStatus {
+    if (const AccountStatus status = validate(tx); status != AccountStatus::Ok) {
+      return status;
+    }
+    const size_t a = shardIndex(tx.from);
+    const size_t b = shardIndex(tx.to);
+    if (a == b) {
+      std::lock_guard<std::mutex> lock(shards_[a].mutex);
+      return applyLocked(tx);
+    }
+    return applyCrossShard(tx, a, b);
+  }
+
+  /**
+   * 批量应用交易，返回成功的笔数
+   * results 不为空时，results[i] 是 transactions[i] 的结果
+   * （C++17 没有 std::span，用指针加长度表示一段连续的交易；一批最多 UINT32_MAX 笔）
+   */
+  auto apply(const Transaction* transactions, size_t count, AccountStatus* results = nullptr)
+    -> size_t {
+    if (count < kSerialCutoff || threads_ == 1) {
+      return applySerial(transactions, count, results);
+    }
+    // 分桶用的缓冲区按调用线程缓存，重复提交批次时不再分配和缺页。
+    // 工作线程通过引用 plan 访问调用线程的缓冲区（lambda 中直接写 scratch 会指向工作线程自己的实例）
+    thread_local Plan scratch;
+    Plan&             plan = scratch;
+    partition(transactions, count, results, plan);
+    const size_t workers = threads_;
+
+    std::atomic<size_t> applied{0};
+    // 第 2 步：每个分片的桶由一个线程在该分片的锁内顺序处理
+    parallelFor(shardCount_, workers, [&](size_t shard) {
+      const Entry* first = plan.buckets.data() + plan.offsets[shard];
+      const Entry* last  = plan.buckets.data() + plan.offsets[shard + 1];
+      if (first == last) {
+        return;
+      }
+      size_t                      ok = 0;
+      std::lock_guard<std::mutex> lock(shards_[shard].mutex);
+      for (const Entry* it = first; it != last; ++it) {
+        const AccountStatus status = applyLocked(it->tx);
+        ok += status == AccountStatus::Ok;
+        store(results, it->index, status);
+      }
+      applied.fetch_add(ok, std::memory_order_relaxed);
+    });
+
+    // 第 3 步：跨分片转账按块分给各个线程，每笔转账同时持有两个分片的锁
+    const std::vector<uint32_t>& cross  = plan.crossShard;
+    const size_t                 chunks = (cross.size() + kCrossChunk - 1) / kCrossChunk;
+    parallelFor(chunks, workers, [&](size_t chunk) {
+      const size_t first = chunk * kCrossChunk;
+      const size_t last  = std::min(first + kCrossChunk, cross.size());
+      size_t       ok    = 0;
+      for (size_t i = first; i < last; ++i) {
+        const Transaction&  tx     = transactions[cross[i]];
+        const AccountStatus status = applyCrossShard(tx, shardIndex(tx.from), shardIndex(tx.to));
+        ok += status == AccountStatus::Ok;
+        store(results, cross[i], status);
+      }
+      applied.fetch_add(ok, std::memory_order_relaxed);
+    });
+    return applied.load(std::memory_order_relaxed);
+  }
+
+  auto apply(const std::vector<Transaction>& transactions, AccountStatus* results = nullptr)
+    -> size_t {
+    return apply(transactions.data(), transactions.size(), results);
+  }
+
+  private:
+  // 每个分片的锁独占一条缓存行，避免不同线程加锁时伪共享
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+  };
+
+  struct Entry {
+    Transaction tx;
+    uint32_t    index;   // 在原数组中的位置，用来写回结果
+  };
+
+  struct Plan {
+    std::vector<size_t>   offsets;      // 分片 s 的交易是 buckets[offsets[s], offsets[s + 1])
+    std::vector<Entry>    buckets;      // 按分片分桶后的交易
+    std::vector<uint32_t> crossShard;   // 跨分片的转账
+    std::vector<size_t>   cursor;       // 分桶时每个桶的写入位置
+  };
+
+  static constexpr size_t kCrossChunk   = 4096;
+  static constexpr size_t kSerialCutoff = 16 * 1024;   // 交易少于这个数时不创建线程
+
+  std::vector<int64_t>     balances_;
+  unsigned                 shardShift_;
+  size_t                   shardCount_;
+  std::unique_ptr<Shard[]> shards_;
+  unsigned                 threads_;
+
+  static auto shiftFor(size_t accounts, size_t shards) -> unsigned {
+    const size_t perShard = (std::max<size_t>(accounts, 1) + std::max<size_t>(shards, 1) - 1) /
+                            std::max<size_t>(shards, 1);
+    unsigned shift = 0;
+    while ((size_t{1} << shift) < perShard) {
+      ++shift;
+    }
+    return shift;
+  }
+
+  [[nodiscard]] auto shardIndex(uint32_t account) const -> size_t { return account >> shardShift_; }
+  [[nodiscard]] auto shardOf(uint32_t account) const -> Shard& {
+    return shards_[shardIndex(account)];
+  }
+
+  static void store(AccountStatus* results, uint32_t index, AccountStatus status) {
+    if (results != nullptr) {
+      results[index] = status;
+    }
+  }
+
+  [[nodiscard]] auto validate(const Transaction& tx) const -> AccountStatus {
+    if (tx.from >= balances_.size() || tx.to >= balances_.size()) {
+      return AccountStatus::UnknownAccount;
+    }
+    if (tx.amount <= 0) {
+      return AccountStatus::InvalidAmount;
+    }
+    return AccountStatus::Ok;
+  }
+
+  // 调用方已经持有 from 和 to 所在分片的锁
+  // 入账超出 int64_t 时返回 Overflow；转账先检查入账再扣款，失败时两个余额都不变
+  auto applyLocked(const Transaction& tx) -> AccountStatus {
+    int64_t credited = 0;
+    switch (tx.kind) {
+    case Transaction::Kind::Deposit:
+      if (__builtin_add_overflow(balances_[tx.to], tx.amount, &credited)) {
+        return AccountStatus::Overflow;
+      }
+      balances_[tx.to] = credited;
+      return AccountStatus::Ok;
+    case Transaction::Kind::Withdraw:
+      if (balances_[tx.from] < tx.amount) {
+        return AccountStatus::InsufficientFunds;
+      }
+      balances_[tx.from] -= tx.amount;
+      return AccountStatus::Ok;
+    case Transaction::Kind::Transfer:
+      if (balances_[tx.from] < tx.amount) {
+        return AccountStatus::InsufficientFunds;
+      }
+      if (tx.from == tx.to) {
+        return AccountStatus::Ok;   // 转给自己，余额不变
+      }
+      if (__builtin_add_overflow(balances_[tx.to], tx.amount, &credited)) {
+        return AccountStatus::Overflow;
+      }
+      balances_[tx.from] -= tx.amount;
+      balances_[tx.to] = credited;
+      return AccountStatus::Ok;
+    }
+    return AccountStatus::InvalidAmount;
+  }
+
+  // 总是先锁编号小的分片，多个线程同时做方向相反的转账也不会死锁
+  auto applyCrossShard(const Transaction& tx, size_t a, size_t b) -> AccountStatus {
+    std::lock_guard<std::mutex> first(shards_[std::min(a, b)].mutex);
+    std::lock_guard<std::mutex> second(shards_[std::max(a, b)].mutex);
+    return applyLocked(tx);
+  }
+
+  auto applySerial(const Transaction* transactions, size_t count, AccountStatus* results)
+    -> size_t {
+    const auto locks = lockAll();
+    size_t     ok    = 0;
+    for (size_t i = 0; i < count; ++i) {
+      AccountStatus status = validate(transactions[i]);
+      if (status == AccountStatus::Ok) {
+        status = applyLocked(transactions[i]);
+      }
+      ok += status == AccountStatus::Ok;
+      store(results, static_cast<uint32_t>(i), status);
+    }
+    return ok;
+  }
+
+  // 按分片编号顺序加锁，与 applyCrossShard 的加锁顺序一致
+  auto lockAll() const -> std::vector<std::unique_lock<std::mutex>> {
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(shardCount_);
+    for (size_t s = 0; s < shardCount_; ++s) {
+      locks.emplace_back(shards_[s].mutex);
+    }
+    return locks;
+  }
+
+  // 第 1 步：非法交易直接写结果；其余按分片计数排序，跨分片转账单独收集
+  void partition(
+    const Transaction* transactions, size_t count, AccountStatus* results, Plan& plan) const {
+    plan.offsets.assign(shardCount_ + 1, 0);
+    plan.crossShard.clear();
+
+    // 第一遍：计数
+    for (size_t i = 0; i < count; ++i) {
+      const Transaction&  tx     = transactions[i];
+      const AccountStatus status = validate(tx);
+      if (status != AccountStatus::Ok) {
+        store(results, static_cast<uint32_t>(i), status);
+        continue;
+      }
+      const size_t a = shardIndex(tx.from);
+      if (a != shardIndex(tx.to)) {
+        plan.crossShard.push_back(static_cast<uint32_t>(i));
+        continue;
+      }
+      ++plan.offsets[a + 1];
+    }
+    for (size_t s = 0; s < shardCount_; ++s) {
+      plan.offsets[s + 1] += plan.offsets[s];
+    }
+
+    plan.buckets.resize(plan.offsets[shardCount_]);
+    std::vector<size_t>& cursor = plan.cursor;
+    cursor.assign(plan.offsets.begin(), plan.offsets.end() - 1);
+    // 第二遍：复制到桶里；定位分片只是移位，重新计算比保存下来再读更省内存带宽
+    for (size_t i = 0; i < count; ++i) {
+      const Transaction& tx = transactions[i];
+      const size_t       a  = shardIndex(tx.from);
+      if (validate(tx) == AccountStatus::Ok && a == shardIndex(tx.to)) {
+        plan.buckets[cursor[a]++] = {tx, static_cast<uint32_t>(i)};
+      }
+    }
+  }
+
+  // 把 tasks 个任务分给最多 maxWorkers 个线程（包括当前线程）
+  template<typename F> static void parallelFor(size_t tasks, size_t maxWorkers, F&& task) {
+    if (tasks == 0) {
+      return;
+    }
+    const size_t workers = std::min(maxWorkers, tasks);
+    if (workers <= 1) {
+      for (size_t t = 0; t < tasks; ++t) {
+        task(t);
+      }
+      return;
+    }
+    std::atomic<size_t> next{0};
+    auto                run = [&] {
+      for (size_t t = next.fetch_add(1); t < tasks; t = next.fetch_add(1)) {
+        task(t);
+      }
+    };
+    std::vector<std::thread> helpers;
+    helpers.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w) {
+      helpers.emplace_back(run);
+    }
+    run();
+    for (auto& helper : helpers) {
+      helper.join();
+    }
+  }
+};
+
+#endif
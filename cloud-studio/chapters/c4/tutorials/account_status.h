@@ -0,0 +1,44 @@
+#ifndef __ACCOUNT_STATUS__H
+#define __ACCOUNT_STATUS__H
+
+/**
+ * @file account_status.h
+ * @brief 账户操作的错误码
+ *
+ * 余额不足、金额非法都是业务中的常规情况，不是异常情况。
+ * 账户类的 tryXxx() 返回 AccountStatus，热路径上不抛异常；
+ * 原来会抛异常的 deposit() / withdraw() 只是在 tryXxx() 失败时把错误码转换成异常。
+ */
+
+enum class AccountStatus
+{
+  Ok,
+  InvalidAmount,       // 金额不是正数
+  InsufficientFunds,   // 余额不足
+  NegativeBalance,     // 设置的余额为负数
+  UnknownAccount,      // 账户编号不存在（AccountLedger）
+  JournalError,        // 写前日志写入失败，余额未修改
+  Overflow,            // 金额超出 Money 能表示的范围
+};
+
+constexpr auto toString(AccountStatus status) -> const char* {
+  switch (status) {
+  case AccountStatus::Ok:
+    return "ok";
+  case AccountStatus::InvalidAmount:
+    return "invalid amount";
+  case AccountStatus::InsufficientFunds:
+    return "insufficient funds";
+  case AccountStatus::NegativeBalance:
+    return "negative balance";
+  case AccountStatus::UnknownAccount:
+    return "unknown account";
+  case AccountStatus::JournalError:
+    return "journal error";
+  case AccountStatus::Overflow:
+    return "overflow";
+  }
+  return "unknown";
+}
+
+#endif
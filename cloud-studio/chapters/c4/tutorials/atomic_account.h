@@ -0,0 +1,102 @@
+#ifndef __ATOMIC_ACCOUNT__H
+#define __ATOMIC_ACCOUNT__H
+
+/**
+ * @file atomic_account.h
+ * @brief 可以被多个线程同时存取款的账户，不使用锁
+ *
+ * tutorial_19 / tutorial_22 中的 BankAccount（bank_account.h）用 Money 保存余额，但没有任何同步，
+ * 多个线程同时 deposit/withdraw 会丢失更新，余额甚至可能变成负数。
+ * AtomicBankAccount：
+ * - 余额是 Money 的分值，保存在 std::atomic<int64_t> 中，加减是精确的整数运算
+ * - tryDeposit 也用 CAS 循环，用 __builtin_add_overflow 检查溢出：结果超出 int64_t 时返回
+ *   AccountStatus::Overflow，余额不变（与 BankAccount 相同），否则回绕成负数会破坏下面的不变式
+ * - tryWithdraw 用 CAS 循环：读出余额，余额不足就失败，否则尝试把它换成扣款后的值，
+ *   期间被其他线程改过就用新值重试，因此“余额永远不为负”的不变式不需要锁也成立
+ * - 每个账户独占一条缓存行，放在数组里时相邻账户不会互相伪共享
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+#include "account_status.h"
+#include "money.h"
+
+class alignas(64) AtomicBankAccount {
+  public:
+  explicit AtomicBankAccount(Money initial = Money()) {
+    if (initial.isNegative()) {
+      throw std::invalid_argument("初始余额不能为负数");
+    }
+    balance_.store(initial.minor(), std::memory_order_relaxed);
+  }
+
+  AtomicBankAccount(const AtomicBankAccount&)                    = delete;
+  auto operator=(const AtomicBankAccount&) -> AtomicBankAccount& = delete;
+
+  [[nodiscard]] auto tryDeposit(Money amount) noexcept -> AccountStatus {
+    if (!amount.isPositive()) {
+      return AccountStatus::InvalidAmount;
+    }
+    const int64_t amountMinor = amount.minor();
+    int64_t       current     = balance_.load(std::memory_order_relaxed);
+    int64_t       next        = 0;
+    do {
+      if (__builtin_add_overflow(current, amountMinor, &next)) {
+        return AccountStatus::Overflow;
+      }
+    } while (!balance_.compare_exchange_weak(
+      current, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+    return AccountStatus::Ok;
+  }
+
+  // 余额不足时返回 InsufficientFunds，余额保持不变
+  [[nodiscard]] auto tryWithdraw(Money amount) noexcept -> AccountStatus {
+    if (!amount.isPositive()) {
+      return AccountStatus::InvalidAmount;
+    }
+    const int64_t amountMinor = amount.minor();
+    int64_t       current     = balance_.load(std::memory_order_relaxed);
+    do {
+      if (current < amountMinor) {
+        return AccountStatus::InsufficientFunds;
+      }
+      // 失败时 compare_exchange_weak 把最新的余额写回 current
+    } while (!balance_.compare_exchange_weak(
+      current, current - amountMinor, std::memory_order_acq_rel, std::memory_order_relaxed));
+    return AccountStatus::Ok;
+  }
+
+  // 与原来的 BankAccount 一样，失败时抛出异常
+  void deposit(Money amount) {
+    const AccountStatus status = tryDeposit(amount);
+    if (status == AccountStatus::InvalidAmount) {
+      throw std::invalid_argument("存款金额必须为正数");
+    }
+    if (status == AccountStatus::Overflow) {
+      throw std::overflow_error("Balance overflow");
+    }
+  }
+
+  void withdraw(Money amount) {
+    const AccountStatus status = tryWithdraw(amount);
+    if (status == AccountStatus::InvalidAmount) {
+      throw std::invalid_argument("取款金额必须为正数");
+    }
+    if (status == AccountStatus::InsufficientFunds) {
+      throw std::runtime_error("余额不足");
+    }
+  }
+
+  [[nodiscard]] auto getBalance() const -> Money {
+    return Money::fromMinor(balance_.load(std::memory_order_acquire));
+  }
+
+  private:
+  std::atomic<int64_t> balance_{0};   // 不变性：余额永远不能为负
+
+  static_assert(std::atomic<int64_t>::is_always_lock_free, "int64_t atomics must be lock-free");
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef __BANK_ACCOUNT__H
+#define __BANK_ACCOUNT__H
+
+/**
+ * @file bank_account.h
+ * @brief 条款 22 中通过 private 成员维护约束条件的 BankAccount
+ *
+ * tryDeposit() / tryWithdraw() 不抛异常，用 AccountStatus 报告金额非法、余额不足；
+ * deposit() / withdraw() 保留原来的异常语义，只是在失败时把错误码转换成异常。
+ * attachJournal() 之后，每次修改余额前都先写入 AccountJournal（写前日志），崩溃后可以重放恢复。
+ * 金额都是 Money（以分为单位的整数），反复存取款不会累积舍入误差。
+ */
+
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "account_journal.h"
+#include "account_status.h"
+#include "money.h"
+
+class BankAccount {
+  public:
+  BankAccount(std::string owner, Money initialBalance = Money())
+    : owner_(std::move(owner)) {
+    setBalance(initialBalance);
+  }
+
+  // 只读访问
+  [[nodiscard]] auto getOwner() const -> const std::string& { return owner_; }
+  [[nodiscard]] auto getBalance() const -> Money { return balance_; }
+
+  // 之后的每次余额修改都先写入 journal；先记录一次当前余额，恢复时才知道这个账户
+  // journal 为 nullptr 表示不再记录。journal 必须比账户活得久
+  auto attachJournal(AccountJournal* journal) -> void {
+    if (journal != nullptr) {
+      if (std::error_code ec = journal->record(owner_, balance_); ec) {
+        throw std::system_error(ec, "journal");
+      }
+    }
+    journal_ = journal;
+  }
+
+  // 不抛异常的存款操作
+  [[nodiscard]] auto tryDeposit(Money amount) noexcept -> AccountStatus {
+    if (!amount.isPositive()) {
+      return AccountStatus::InvalidAmount;
+    }
+    Money newBalance;
+    if (!Money::tryAdd(balance_, amount, newBalance)) {
+      return AccountStatus::Overflow;
+    }
+    return trySetBalance(newBalance);
+  }
+
+  // 不抛异常的取款操作：余额不足时余额保持不变
+  [[nodiscard]] auto tryWithdraw(Money amount) noexcept -> AccountStatus {
+    if (!amount.isPositive()) {
+      return AccountStatus::InvalidAmount;
+    }
+    if (amount > balance_) {
+      return AccountStatus::InsufficientFunds;
+    }
+    // 0 <= balance_ - amount < balance_，不会溢出
+    return trySetBalance(Money::fromMinor(balance_.minor() - amount.minor()));
+  }
+
+  // 存款操作
+  auto deposit(Money amount) -> void {
+    if (const AccountStatus status = tryDeposit(amount); status != AccountStatus::Ok) {
+      raise(status, "Deposit amount must be positive");
+    }
+  }
+
+  // 取款操作
+  auto withdraw(Money amount) -> void {
+    if (const AccountStatus status = tryWithdraw(amount); status != AccountStatus::Ok) {
+      raise(status, "Withdrawal amount must be positive");
+    }
+  }
+
+  private:
+  std::string     owner_;
+  Money           balance_;
+  AccountJournal* journal_ = nullptr;
+
+  // 私有辅助函数，确保余额更新的一致性
+  auto trySetBalance(Money newBalance) noexcept -> AccountStatus {
+    if (newBalance.isNegative()) {
+      return AccountStatus::NegativeBalance;
+    }
+    // 写前日志：记录写好之后才修改内存中的余额，写入失败时余额保持不变
+    if (journal_ != nullptr && journal_->record(owner_, newBalance)) {
+      return AccountStatus::JournalError;
+    }
+    balance_ = newBalance;
+    // 这里可以添加其他逻辑，如通知观察者等
+    return AccountStatus::Ok;
+  }
+
+  auto setBalance(Money newBalance) -> void {
+    if (const AccountStatus status = trySetBalance(newBalance); status != AccountStatus::Ok) {
+      raise(status, "");
+    }
+  }
+
+  // 错误码转换成异常；放在单独的冷函数里，正常路径上只剩一次比较
+  [[noreturn]] static void raise(AccountStatus status, const char* invalidAmountMessage) {
+    switch (status) {
+    case AccountStatus::InvalidAmount:
+      throw std::invalid_argument(invalidAmountMessage);
+    case AccountStatus::InsufficientFunds:
+      throw std::runtime_error("Insufficient funds");
+    case AccountStatus::JournalError:
+      throw std::runtime_error("Journal write failed");
+    case AccountStatus::Overflow:
+      throw std::overflow_error("Balance overflow");
+    case AccountStatus::NegativeBalance:
+    case AccountStatus::UnknownAccount:
+    case AccountStatus::Ok:
+      break;
+    }
+    throw std::invalid_argument("Balance cannot be negative");
+  }
+};
+
+#endif
@@ -0,0 +1,516 @@
+#ifndef __BIG_INTEGER__H
+#define __BIG_INTEGER__H
+
+/**
+ * @file big_integer.h
+ * @brief 任意精度整数，供 big_rational.h 在数值超出 64 位时使用
+ *
+ * 符号 + 绝对值表示：绝对值是 64 位 limb 的数组（低位在前，没有前导 0），零没有 limb、符号为正。
+ * - 乘法：短的操作数用逐位相乘（schoolbook），两个操作数都不短于 kKaratsubaThreshold 个 limb 时
+ *   用 Karatsuba，把一次 n×n 乘法换成三次 n/2×n/2 乘法
+ * - 除法：Knuth 4.3.1 的算法 D，试商用 128 位整数计算
+ * - gcd：Lehmer 算法。用两个数最高的 62 位模拟若干步欧几里得算法，得到 2×2 的系数矩阵后
+ *   一次性作用到整个数上，代替逐步的多精度除法；剩下一个 limb 时改用二进制 GCD
+ * 除以零抛出 std::domain_error。
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rational.h"
+
+namespace big_detail {
+
+using Limb  = uint64_t;
+using Limbs = std::vector<Limb>;
+
+constexpr size_t kKaratsubaThreshold = 48;
+
+inline void trim(Limbs& limbs) {
+  while (!limbs.empty() && limbs.back() == 0) {
+    limbs.pop_back();
+  }
+}
+
+inline auto compare(const Limbs& a, const Limbs& b) -> int {
+  if (a.size() != b.size()) {
+    return a.size() < b.size() ? -1 : 1;
+  }
+  for (size_t i = a.size(); i-- > 0;) {
+    if (a[i] != b[i]) {
+      return a[i] < b[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+inline auto add(const Limbs& a, const Limbs& b) -> Limbs {
+  const Limbs& longer  = a.size() >= b.size() ? a : b;
+  const Limbs& shorter = a.size() >= b.size() ? b : a;
+  Limbs        sum(longer.size() + 1);
+  Limb         carry = 0;
+  for (size_t i = 0; i < longer.size(); ++i) {
+    const unsigned __int128 s =
+      static_cast<unsigned __int128>(longer[i]) + (i < shorter.size() ? shorter[i] : 0) + carry;
+    sum[i] = static_cast<Limb>(s);
+    carry  = static_cast<Limb>(s >> 64);
+  }
+  sum.back() = carry;
+  trim(sum);
+  return sum;
+}
+
+// a -= b，要求 a >= b
+inline void subtractInPlace(Limbs& a, const Limbs& b) {
+  Limb borrow = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    const Limb rhs = i < b.size() ? b[i] : 0;
+    const Limb d   = a[i] - rhs - borrow;
+    borrow         = (a[i] < rhs || (a[i] == rhs && borrow)) ? 1 : 0;
+    a[i]           = d;
+    if (i >= b.size() && borrow == 0) {
+      break;
+    }
+  }
+  trim(a);
+}
+
+// 把 a[0, na) 与 b[0, nb) 的乘积累加到 out[0, na + nb)
+inline void mulSchoolbook(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* out) {
+  for (size_t i = 0; i < na; ++i) {
+    Limb carry = 0;
+    for (size_t j = 0; j < nb; ++j) {
+      const unsigned __int128 t =
+        static_cast<unsigned __int128>(a[i]) * b[j] + out[i + j] + carry;
+      out[i + j] = static_cast<Limb>(t);
+      carry      = static_cast<Limb>(t >> 64);
+    }
+    for (size_t k = i + nb; carry != 0; ++k) {
+      const unsigned __int128 t = static_cast<unsigned __int128>(out[k]) + carry;
+      out[k]                    = static_cast<Limb>(t);
+      carry                     = static_cast<Limb>(t >> 64);
+    }
+  }
+}
+
+// 把 value 左移 shift 个 limb 后累加到 out
+inline void addShifted(Limbs& out, const Limbs& value, size_t shift) {
+  Limb carry = 0;
+  size_t i   = 0;
+  for (; i < value.size(); ++i) {
+    const unsigned __int128 t =
+      static_cast<unsigned __int128>(out[shift + i]) + value[i] + carry;
+    out[shift + i] = static_cast<Limb>(t);
+    carry          = static_cast<Limb>(t >> 64);
+  }
+  for (size_t k = shift + i; carry != 0; ++k) {
+    out[k] += carry;
+    carry = out[k] == 0 ? 1 : 0;
+  }
+}
+
+inline auto slice(const Limbs& limbs, size_t from, size_t to) -> Limbs {
+  Limbs part(limbs.begin() + static_cast<ptrdiff_t>(std::min(from, limbs.size())),
+             limbs.begin() + static_cast<ptrdiff_t>(std::min(to, limbs.size())));
+  trim(part);
+  return part;
+}
+
+inline auto multiply(const Limbs& a, const Limbs& b) -> Limbs;
+
+// Karatsuba：a = a1·B^m + a0，b = b1·B^m + b0，
+// a·b = z2·B^2m + (z1 - z2 - z0)·B^m + z0，其中 z0 = a0·b0，z2 = a1·b1，z1 = (a0 + a1)(b0 + b1)
+inline auto mulKaratsuba(const Limbs& a, const Limbs& b) -> Limbs {
+  const size_t m  = std::min(a.size(), b.size()) / 2;
+  const Limbs  a0 = slice(a, 0, m);
+  const Limbs  a1 = slice(a, m, a.size());
+  const Limbs  b0 = slice(b, 0, m);
+  const Limbs  b1 = slice(b, m, b.size());
+  const Limbs  z0 = multiply(a0, b0);
+  const Limbs  z2 = multiply(a1, b1);
+  Limbs        z1 = multiply(add(a0, a1), add(b0, b1));
+  subtractInPlace(z1, z0);
+  subtractInPlace(z1, z2);
+
+  Limbs product(a.size() + b.size() + 1);
+  addShifted(product, z0, 0);
+  addShifted(product, z1, m);
+  addShifted(product, z2, 2 * m);
+  trim(product);
+  return product;
+}
+
+inline auto multiply(const Limbs& a, const Limbs& b) -> Limbs {
+  if (a.empty() || b.empty()) {
+    return {};
+  }
+  if (std::min(a.size(), b.size()) >= kKaratsubaThreshold) {
+    return mulKaratsuba(a, b);
+  }
+  Limbs product(a.size() + b.size());
+  mulSchoolbook(a.data(), a.size(), b.data(), b.size(), product.data());
+  trim(product);
+  return product;
+}
+
+// 除以单个 limb，返回余数
+inline auto divideBySmall(Limbs& a, Limb divisor) -> Limb {
+  unsigned __int128 remainder = 0;
+  for (size_t i = a.size(); i-- > 0;) {
+    const unsigned __int128 current = (remainder << 64) | a[i];
+    a[i]                            = static_cast<Limb>(current / divisor);
+    remainder                       = current % divisor;
+  }
+  trim(a);
+  return static_cast<Limb>(remainder);
+}
+
+inline auto shiftLeftBits(const Limbs& a, int bits, size_t extra) -> Limbs {
+  Limbs shifted(a.size() + extra);
+  Limb  carry = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    shifted[i] = bits == 0 ? a[i] : (a[i] << bits) | carry;
+    carry      = bits == 0 ? 0 : a[i] >> (64 - bits);
+  }
+  if (extra != 0) {
+    shifted[a.size()] = carry;
+  }
+  return shifted;
+}
+
+// Knuth 算法 D：quotient = u / v，remainder = u % v，要求 v 至少两个 limb 且 u >= v
+inline void divideKnuth(const Limbs& u, const Limbs& v, Limbs& quotient, Limbs& remainder) {
+  const int    shift = __builtin_clzll(v.back());   // 规格化：除数最高位为 1，试商最多偏大 2
+  const Limbs  vn    = shiftLeftBits(v, shift, 0);
+  Limbs        un    = shiftLeftBits(u, shift, 1);
+  const size_t n     = vn.size();
+  const size_t m     = u.size() - n;
+  quotient.assign(m + 1, 0);
+
+  for (size_t j = m + 1; j-- > 0;) {
+    const unsigned __int128 top = (static_cast<unsigned __int128>(un[j + n]) << 64) | un[j + n - 1];
+    unsigned __int128       qhat = top / vn[n - 1];
+    unsigned __int128       rhat = top % vn[n - 1];
+    while ((qhat >> 64) != 0 ||
+           qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+      --qhat;
+      rhat += vn[n - 1];
+      if ((rhat >> 64) != 0) {
+        break;
+      }
+    }
+
+    // un[j, j + n] -= qhat * vn
+    Limb     carry  = 0;
+    __int128 borrow = 0;
+    for (size_t i = 0; i < n; ++i) {
+      const unsigned __int128 p = qhat * vn[i] + carry;
+      carry                     = static_cast<Limb>(p >> 64);
+      const __int128 t = static_cast<__int128>(un[i + j]) - static_cast<Limb>(p) + borrow;
+      un[i + j]        = static_cast<Limb>(t);
+      borrow           = t >> 64;
+    }
+    const __int128 t = static_cast<__int128>(un[j + n]) - carry + borrow;
+    un[j + n]        = static_cast<Limb>(t);
+
+    if (t < 0) {
+      // 试商大了 1：加回一个除数
+      --qhat;
+      Limb c = 0;
+      for (size_t i = 0; i < n; ++i) {
+        const unsigned __int128 s = static_cast<unsigned __int128>(un[i + j]) + vn[i] + c;
+        un[i + j]                 = static_cast<Limb>(s);
+        c                         = static_cast<Limb>(s >> 64);
+      }
+      un[j + n] += c;
+    }
+    quotient[j] = static_cast<Limb>(qhat);
+  }
+  trim(quotient);
+
+  remainder.assign(n, 0);
+  for (size_t i = 0; i < n; ++i) {
+    remainder[i] = shift == 0 ? un[i] : (un[i] >> shift) | (un[i + 1] << (64 - shift));
+  }
+  trim(remainder);
+}
+
+inline void divide(const Limbs& u, const Limbs& v, Limbs& quotient, Limbs& remainder) {
+  if (v.empty()) {
+    throw std::domain_error("BigInteger: division by zero");
+  }
+  if (compare(u, v) < 0) {
+    quotient.clear();
+    remainder = u;
+    return;
+  }
+  if (v.size() == 1) {
+    quotient        = u;
+    const Limb rest = divideBySmall(quotient, v[0]);
+    remainder.assign(rest == 0 ? 0 : 1, rest);
+    return;
+  }
+  divideKnuth(u, v, quotient, remainder);
+}
+
+inline auto bitLength(const Limbs& a) -> size_t {
+  return a.empty() ? 0 : 64 * a.size() - static_cast<size_t>(__builtin_clzll(a.back()));
+}
+
+// 从第 bit 位开始取 62 位
+inline auto bitsAt(const Limbs& a, size_t bit) -> int64_t {
+  const size_t index  = bit / 64;
+  const int    offset = static_cast<int>(bit % 64);
+  Limb         low    = index < a.size() ? a[index] >> offset : 0;
+  if (offset != 0 && index + 1 < a.size()) {
+    low |= a[index + 1] << (64 - offset);
+  }
+  return static_cast<int64_t>(low & ((Limb{1} << 62) - 1));
+}
+
+// result = x·a + y·b，x、y 一正一负（或其一为 0），|x|、|y| < 2^62，结果非负
+inline auto combine(int64_t x, const Limbs& a, int64_t y, const Limbs& b) -> Limbs {
+  Limbs    result(a.size());
+  __int128 carry = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    const __int128 t = carry + static_cast<__int128>(x) * a[i] +
+                       static_cast<__int128>(y) * (i < b.size() ? b[i] : 0);
+    result[i]        = static_cast<Limb>(t);
+    carry            = t >> 64;
+  }
+  trim(result);
+  return result;
+}
+
+// Lehmer gcd（Knuth 4.5.2 算法 L），u、v 为绝对值
+inline auto gcd(Limbs u, Limbs v) -> Limbs {
+  if (compare(u, v) < 0) {
+    std::swap(u, v);
+  }
+  while (v.size() >= 2) {
+    // u、v 最高的 62 位（v 按 u 的位置对齐）
+    const size_t shift = bitLength(u) - 62;
+    int64_t      x     = bitsAt(u, shift);
+    int64_t      y     = bitsAt(v, shift);
+    int64_t      a     = 1;
+    int64_t      b     = 0;
+    int64_t      c     = 0;
+    int64_t      d     = 1;
+    // 只在 (x + a) / (y + c) 与 (x + b) / (y + d) 相同、即商一定正确时继续
+    while (y + c != 0 && y + d != 0) {
+      const int64_t q = (x + a) / (y + c);
+      if (q != (x + b) / (y + d)) {
+        break;
+      }
+      int64_t t = a - q * c;
+      a         = c;
+      c         = t;
+      t         = b - q * d;
+      b         = d;
+      d         = t;
+      t         = x - q * y;
+      x         = y;
+      y         = t;
+    }
+    if (b == 0) {
+      // 没有进展（两个商不一致）：做一步多精度除法
+      Limbs quotient;
+      Limbs remainder;
+      divide(u, v, quotient, remainder);
+      u = std::move(v);
+      v = std::move(remainder);
+    } else {
+      Limbs nextU = combine(a, u, b, v);
+      Limbs nextV = combine(c, u, d, v);
+      u           = std::move(nextU);
+      v           = std::move(nextV);
+    }
+  }
+  if (v.empty()) {
+    return u;
+  }
+  const Limb small = divideBySmall(u, v[0]);
+  const Limb g     = rational_detail::binaryGcd(small, v[0]);
+  return Limbs{g};
+}
+
+}   // namespace big_detail
+
+class BigInteger {
+  public:
+  BigInteger() = default;
+  // 与内置整数一样可以隐式转换
+  BigInteger(int64_t value)
+    : negative_(value < 0) {
+    if (value != 0) {
+      limbs_.push_back(rational_detail::magnitude(value));
+    }
+  }
+
+  [[nodiscard]] auto isZero() const -> bool { return limbs_.empty(); }
+  [[nodiscard]] auto isNegative() const -> bool { return negative_; }
+  [[nodiscard]] auto limbCount() const -> size_t { return limbs_.size(); }
+
+  [[nodiscard]] auto fitsInt64() const -> bool {
+    if (limbs_.size() > 1) {
+      return false;
+    }
+    if (limbs_.empty()) {
+      return true;
+    }
+    const uint64_t limit = negative_ ? uint64_t{1} << 63 : (uint64_t{1} << 63) - 1;
+    return limbs_[0] <= limit;
+  }
+
+  // 调用前用 fitsInt64() 检查
+  [[nodiscard]] auto toInt64() const -> int64_t {
+    if (limbs_.empty()) {
+      return 0;
+    }
+    return negative_ ? static_cast<int64_t>(0 - limbs_[0]) : static_cast<int64_t>(limbs_[0]);
+  }
+
+  [[nodiscard]] auto toDouble() const -> double {
+    double value = 0;
+    for (size_t i = limbs_.size(); i-- > 0;) {
+      value = value * 18446744073709551616.0 + static_cast<double>(limbs_[i]);
+    }
+    return negative_ ? -value : value;
+  }
+
+  [[nodiscard]] auto toString() const -> std::string {
+    if (limbs_.empty()) {
+      return "0";
+    }
+    // 每次除以 10^19，得到 19 位十进制数字
+    constexpr big_detail::Limb kChunk = 10'000'000'000'000'000'000ULL;
+    big_detail::Limbs          rest   = limbs_;
+    std::string                digits;
+    while (!rest.empty()) {
+      big_detail::Limb chunk = big_detail::divideBySmall(rest, kChunk);
+      for (int i = 0; i < 19 && (chunk != 0 || !rest.empty()); ++i) {
+        digits.push_back(static_cast<char>('0' + chunk % 10));
+        chunk /= 10;
+      }
+    }
+    if (negative_) {
+      digits.push_back('-');
+    }
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+  }
+
+  auto operator-() const -> BigInteger {
+    BigInteger result = *this;
+    result.negative_  = !limbs_.empty() && !negative_;
+    return result;
+  }
+
+  [[nodiscard]] auto abs() const -> BigInteger {
+    BigInteger result = *this;
+    result.negative_  = false;
+    return result;
+  }
+
+  auto operator+=(const BigInteger& rhs) -> BigInteger& { return addSigned(rhs, rhs.negative_); }
+  auto operator-=(const BigInteger& rhs) -> BigInteger& { return addSigned(rhs, !rhs.negative_); }
+
+  auto operator*=(const BigInteger& rhs) -> BigInteger& {
+    limbs_    = big_detail::multiply(limbs_, rhs.limbs_);
+    negative_ = !limbs_.empty() && negative_ != rhs.negative_;
+    return *this;
+  }
+
+  // 向零取整，余数与被除数同号（与内置整数相同）
+  static void divMod(
+    const BigInteger& lhs, const BigInteger& rhs, BigInteger& quotient, BigInteger& remainder) {
+    big_detail::Limbs q;
+    big_detail::Limbs r;
+    big_detail::divide(lhs.limbs_, rhs.limbs_, q, r);
+    quotient.limbs_     = std::move(q);
+    quotient.negative_  = !quotient.limbs_.empty() && lhs.negative_ != rhs.negative_;
+    remainder.limbs_    = std::move(r);
+    remainder.negative_ = !remainder.limbs_.empty() && lhs.negative_;
+  }
+
+  auto operator/=(const BigInteger& rhs) -> BigInteger& {
+    BigInteger remainder;
+    divMod(*this, rhs, *this, remainder);
+    return *this;
+  }
+
+  auto operator%=(const BigInteger& rhs) -> BigInteger& {
+    BigInteger quotient;
+    divMod(*this, rhs, quotient, *this);
+    return *this;
+  }
+
+  // 非负的最大公约数；gcd(0, 0) == 0
+  [[nodiscard]] static auto gcd(const BigInteger& a, const BigInteger& b) -> BigInteger {
+    BigInteger result;
+    result.limbs_ = big_detail::gcd(a.limbs_, b.limbs_);
+    return result;
+  }
+
+  [[nodiscard]] static auto compare(const BigInteger& a, const BigInteger& b) -> int {
+    if (a.negative_ != b.negative_) {
+      return a.negative_ ? -1 : 1;
+    }
+    const int magnitude = big_detail::compare(a.limbs_, b.limbs_);
+    return a.negative_ ? -magnitude : magnitude;
+  }
+
+  private:
+  big_detail::Limbs limbs_;
+  bool              negative_ = false;
+
+  auto addSigned(const BigInteger& rhs, bool rhsNegative) -> BigInteger& {
+    if (negative_ == rhsNegative) {
+      limbs_ = big_detail::add(limbs_, rhs.limbs_);
+    } else if (big_detail::compare(limbs_, rhs.limbs_) >= 0) {
+      big_detail::subtractInPlace(limbs_, rhs.limbs_);
+    } else {
+      big_detail::Limbs difference = rhs.limbs_;
+      big_detail::subtractInPlace(difference, limbs_);
+      limbs_    = std::move(difference);
+      negative_ = rhsNegative;
+    }
+    negative_ = negative_ && !limbs_.empty();
+    return *this;
+  }
+};
+
+inline auto operator+(BigInteger lhs, const BigInteger& rhs) -> BigInteger { return lhs += rhs; }
+inline auto operator-(BigInteger lhs, const BigInteger& rhs) -> BigInteger { return lhs -= rhs; }
+inline auto operator*(BigInteger lhs, const BigInteger& rhs) -> BigInteger { return lhs *= rhs; }
+inline auto operator/(BigInteger lhs, const BigInteger& rhs) -> BigInteger { return lhs /= rhs; }
+inline auto operator%(BigInteger lhs, const BigInteger& rhs) -> BigInteger { return lhs %= rhs; }
+
+inline auto operator==(const BigInteger& lhs, const BigInteger& rhs) -> bool {
+  return BigInteger::compare(lhs, rhs) == 0;
+}
+inline auto operator!=(const BigInteger& lhs, const BigInteger& rhs) -> bool {
+  return !(lhs == rhs);
+}
+inline auto operator<(const BigInteger& lhs, const BigInteger& rhs) -> bool {
+  return BigInteger::compare(lhs, rhs) < 0;
+}
+inline auto operator>(const BigInteger& lhs, const BigInteger& rhs) -> bool { return rhs < lhs; }
+inline auto operator<=(const BigInteger& lhs, const BigInteger& rhs) -> bool {
+  return !(rhs < lhs);
+}
+inline auto operator>=(const BigInteger& lhs, const BigInteger& rhs) -> bool {
+  return !(lhs < rhs);
+}
+
+inline auto operator<<(std::ostream& os, const BigInteger& value) -> std::ostream& {
+  return os << value.toString();
+}
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef __BIG_RATIONAL__H
+#define __BIG_RATIONAL__H
+
+/**
+ * @file big_rational.h
+ * @brief 任意精度有理数：64 位以内的值直接存放在对象内，超出时转为 BigInteger
+ *
+ * 对账等场景需要精确的有理数运算，中间结果可能超出 64 位。BigRational 有两种表示：
+ * - 内联：分子、分母都在 int64_t 范围内时就是一个 Rational64，不分配内存
+ * - 大数：任一部分超出 int64_t 时，分子、分母作为 BigInteger 存放在堆上
+ * 运算先尝试 Rational64::tryMul / tryAdd / trySub；只有操作数是大数或结果溢出时才走大数路径。
+ * 大数结果约分后如果又回到 int64_t 范围内，就转回内联表示，所以同一个值只有一种表示。
+ *
+ * 与 Rational64 一样，运算符是非成员、非友元函数，两个操作数都可以由整数隐式转换。
+ */
+
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "big_integer.h"
+#include "rational.h"
+
+class BigRational {
+  public:
+  // 不声明为 explicit：与条款 24 一样，整数可以隐式转换成有理数
+  BigRational(int64_t numerator = 0, int64_t denominator = 1) {
+    if (denominator < 0 && (numerator == INT64_MIN || denominator == INT64_MIN)) {
+      // 把符号移到分子上时可能超出 int64_t（例如 INT64_MIN / -1），改走 BigInteger 路径
+      *this = BigRational(BigInteger(numerator), BigInteger(denominator));
+      return;
+    }
+    small_ = Rational64(numerator, denominator);
+  }
+  BigRational(const Rational64& value)
+    : small_(value) {}
+  BigRational(BigInteger numerator, BigInteger denominator) {
+    if (denominator.isZero()) {
+      throw std::invalid_argument("Denominator cannot be zero");
+    }
+    const BigInteger g = BigInteger::gcd(numerator, denominator);
+    numerator /= g;
+    denominator /= g;
+    if (denominator.isNegative()) {
+      numerator   = -numerator;
+      denominator = -denominator;
+    }
+    assignReduced(std::move(numerator), std::move(denominator));
+  }
+
+  BigRational(const BigRational& other)
+    : small_(other.small_)
+    , big_(other.big_ ? std::make_unique<Big>(*other.big_) : nullptr) {}
+  BigRational(BigRational&&) noexcept = default;
+  auto operator=(const BigRational& other) -> BigRational& {
+    if (this != &other) {
+      small_ = other.small_;
+      big_   = other.big_ ? std::make_unique<Big>(*other.big_) : nullptr;
+    }
+    return *this;
+  }
+  auto operator=(BigRational&&) noexcept -> BigRational& = default;
+  ~BigRational()                                         = default;
+
+  // 值在 int64_t 范围内（没有堆分配）
+  [[nodiscard]] auto isInline() const -> bool { return !big_; }
+  // 仅当 isInline() 时有意义
+  [[nodiscard]] auto small() const -> const Rational64& { return small_; }
+
+  [[nodiscard]] auto numerator() const -> BigInteger {
+    return big_ ? big_->num : BigInteger(small_.numerator());
+  }
+  [[nodiscard]] auto denominator() const -> BigInteger {
+    return big_ ? big_->den : BigInteger(small_.denominator());
+  }
+
+  [[nodiscard]] auto toDouble() const -> double {
+    return big_ ? big_->num.toDouble() / big_->den.toDouble() : small_.toDouble();
+  }
+
+  [[nodiscard]] auto toString() const -> std::string {
+    if (!big_) {
+      return small_.isInteger()
+               ? std::to_string(small_.numerator())
+               : std::to_string(small_.numerator()) + '/' + std::to_string(small_.denominator());
+    }
+    if (big_->den == 1) {
+      return big_->num.toString();
+    }
+    return big_->num.toString() + '/' + big_->den.toString();
+  }
+
+  auto operator-() const -> BigRational {
+    if (!big_ && small_.numerator() != INT64_MIN) {
+      return BigRational(-small_);
+    }
+    return BigRational(-numerator(), denominator());
+  }
+
+  auto operator*=(const BigRational& rhs) -> BigRational& {
+    if (!big_ && !rhs.big_ && Rational64::tryMul(small_, rhs.small_, small_)) {
+      return *this;
+    }
+    return multiplyBig(rhs.numerator(), rhs.denominator());
+  }
+
+  auto operator/=(const BigRational& rhs) -> BigRational& {
+    if (!rhs.big_ && rhs.small_.numerator() == 0) {
+      throw std::domain_error("BigRational: division by zero");
+    }
+    if (!big_ && !rhs.big_ && rhs.small_.numerator() != INT64_MIN &&
+        Rational64::tryMul(small_, rhs.small_.reciprocal(), small_)) {
+      return *this;
+    }
+    // 乘以倒数，符号放在分子上
+    BigInteger num = rhs.denominator();
+    BigInteger den = rhs.numerator();
+    if (den.isNegative()) {
+      num = -num;
+      den = -den;
+    }
+    return multiplyBig(num, den);
+  }
+
+  auto operator+=(const BigRational& rhs) -> BigRational& {
+    if (!big_ && !rhs.big_ && Rational64::tryAdd(small_, rhs.small_, small_)) {
+      return *this;
+    }
+    return addBig(rhs.numerator(), rhs.denominator());
+  }
+
+  auto operator-=(const BigRational& rhs) -> BigRational& {
+    if (!big_ && !rhs.big_ && Rational64::trySub(small_, rhs.small_, small_)) {
+      return *this;
+    }
+    return addBig(-rhs.numerator(), rhs.denominator());
+  }
+
+  private:
+  struct Big {
+    BigInteger num;
+    BigInteger den;
+  };
+
+  Rational64           small_;
+  std::unique_ptr<Big> big_;   // 为空时值在 small_ 中
+
+  // n / d 已经约分且 d > 0：能放进 int64_t 就转回内联表示
+  void assignReduced(BigInteger n, BigInteger d) {
+    if (n.fitsInt64() && d.fitsInt64()) {
+      small_ = Rational64(n.toInt64(), d.toInt64());
+      big_.reset();
+      return;
+    }
+    if (big_) {
+      big_->num = std::move(n);
+      big_->den = std::move(d);
+    } else {
+      big_ = std::make_unique<Big>(Big{std::move(n), std::move(d)});
+    }
+  }
+
+  // 与 Rational64 相同的交叉约分：(a/b) * (c/d)，先约掉 gcd(a, d) 和 gcd(c, b)
+  auto multiplyBig(const BigInteger& c, const BigInteger& d) -> BigRational& {
+    const BigInteger a  = numerator();
+    const BigInteger b  = denominator();
+    const BigInteger g1 = BigInteger::gcd(a, d);
+    const BigInteger g2 = BigInteger::gcd(c, b);
+    assignReduced((a / g1) * (c / g2), (b / g2) * (d / g1));
+    return *this;
+  }
+
+  // 与 Rational64 相同的 Knuth 加法：g = gcd(b, d)，t = a(d/g) + c(b/g)，结果 (t/g2) / ((b/g)(d/g2))
+  auto addBig(const BigInteger& c, const BigInteger& d) -> BigRational& {
+    const BigInteger a = numerator();
+    const BigInteger b = denominator();
+    const BigInteger g = BigInteger::gcd(b, d);
+    const BigInteger t = a * (d / g) + c * (b / g);
+    if (t.isZero()) {
+      assignReduced(0, 1);
+      return *this;
+    }
+    const BigInteger g2 = BigInteger::gcd(t, g);
+    assignReduced(t / g2, (b / g) * (d / g2));
+    return *this;
+  }
+};
+
+inline auto operator*(BigRational lhs, const BigRational& rhs) -> BigRational { return lhs *= rhs; }
+inline auto operator/(BigRational lhs, const BigRational& rhs) -> BigRational { return lhs /= rhs; }
+inline auto operator+(BigRational lhs, const BigRational& rhs) -> BigRational { return lhs += rhs; }
+inline auto operator-(BigRational lhs, const BigRational& rhs) -> BigRational { return lhs -= rhs; }
+
+// 表示唯一：一个内联、一个是大数时一定不相等
+inline auto operator==(const BigRational& lhs, const BigRational& rhs) -> bool {
+  if (lhs.isInline() || rhs.isInline()) {
+    return lhs.isInline() && rhs.isInline() && lhs.small() == rhs.small();
+  }
+  return lhs.numerator() == rhs.numerator() && lhs.denominator() == rhs.denominator();
+}
+inline auto operator!=(const BigRational& lhs, const BigRational& rhs) -> bool {
+  return !(lhs == rhs);
+}
+inline auto operator<(const BigRational& lhs, const BigRational& rhs) -> bool {
+  if (lhs.isInline() && rhs.isInline()) {
+    return lhs.small() < rhs.small();
+  }
+  return lhs.numerator() * rhs.denominator() < rhs.numerator() * lhs.denominator();
+}
+inline auto operator>(const BigRational& lhs, const BigRational& rhs) -> bool { return rhs < lhs; }
+inline auto operator<=(const BigRational& lhs, const BigRational& rhs) -> bool {
+  return !(rhs < lhs);
+}
+inline auto operator>=(const BigRational& lhs, const BigRational& rhs) -> bool {
+  return !(lhs < rhs);
+}
+
+inline auto operator<<(std::ostream& os, const BigRational& value) -> std::ostream& {
+  return os << value.toString();
+}
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef __BUFFER_POOL__H
+#define __BUFFER_POOL__H
+
+/**
+ * @file buffer_pool.h
+ * @brief 定长缓冲区的线程局部回收池
+ *
+ * ResourceManager 每次构造/拷贝都 new int[100]，析构时 delete[]。
+ * FixedBufferPool<BlockBytes> 为每个线程维护一条空闲链表：
+ * - acquire() 优先从本线程链表头取一块（命中），链表为空才调用 operator new（未命中）
+ * - release() 把块挂回本线程链表头；链表已有 MaxCached 块时才真正释放，避免无限增长
+ * - 不同线程之间没有锁；在 A 线程申请、B 线程释放的块会进入 B 的链表，之后由 B 复用
+ * - 每个线程的计数器只由本线程写入，localStats() / globalStats() 汇总命中率和占用
+ *
+ * 注意：线程退出时其链表中的块会被释放；不要在线程局部对象析构之后再调用 release()。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+struct PoolStats {
+  uint64_t hits      = 0;   // 从空闲链表取到块
+  uint64_t misses    = 0;   // 调用 operator new
+  uint64_t releases  = 0;   // release() 次数
+  uint64_t freed     = 0;   // 真正归还给 operator delete 的块
+  uint64_t cached    = 0;   // 当前躺在空闲链表里的块（占用）
+  uint64_t highWater = 0;   // 单个线程链表曾经达到的最大长度
+
+  [[nodiscard]] auto acquires() const -> uint64_t { return hits + misses; }
+
+  [[nodiscard]] auto hitRate() const -> double {
+    return acquires() == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(acquires());
+  }
+
+  // 已经交给调用方、尚未归还的块
+  [[nodiscard]] auto outstanding() const -> uint64_t { return misses - freed - cached; }
+
+  auto operator+=(const PoolStats& other) -> PoolStats& {
+    hits += other.hits;
+    misses += other.misses;
+    releases += other.releases;
+    freed += other.freed;
+    cached += other.cached;
+    highWater = std::max(highWater, other.highWater);
+    return *this;
+  }
+};
+
+template<size_t BlockBytes, size_t MaxCached = 1024> class FixedBufferPool {
+  static_assert(BlockBytes >= sizeof(void*), "block must be able to hold a free-list link");
+
+  public:
+  static auto acquire() -> void* {
+    LocalCache& cache = local();
+    if (cache.head != nullptr) {
+      FreeNode* node = cache.head;
+      cache.head     = node->next;
+      --cache.length;
+      bump(cache.counters.hits);
+      cache.counters.cached.store(cache.length, std::memory_order_relaxed);
+      return node;
+    }
+    void* block = ::operator new(BlockBytes);
+    bump(cache.counters.misses);
+    return block;
+  }
+
+  static void release(void* block) noexcept {
+    if (block == nullptr) {
+      return;
+    }
+    LocalCache& cache = local();
+    bump(cache.counters.releases);
+    if (cache.length >= MaxCached) {
+      ::operator delete(block);
+      bump(cache.counters.freed);
+      return;
+    }
+    auto* node = static_cast<FreeNode*>(block);
+    node->next = cache.head;
+    cache.head = node;
+    ++cache.length;
+    cache.counters.cached.store(cache.length, std::memory_order_relaxed);
+    if (cache.length > cache.counters.highWater.load(std::memory_order_relaxed)) {
+      cache.counters.highWater.store(cache.length, std::memory_order_relaxed);
+    }
+  }
+
+  // 当前线程的统计
+  static auto localStats() -> PoolStats { return local().counters.snapshot(); }
+
+  // 所有存活线程加上已退出线程的统计
+  static auto globalStats() -> PoolStats {
+    Registry&                   reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    PoolStats                   total = reg.retired;
+    for (const LocalCache* cache : reg.caches) {
+      total += cache->counters.snapshot();
+    }
+    return total;
+  }
+
+  // 释放当前线程缓存的所有块（例如在负载高峰过去之后）
+  static void trimLocal() noexcept { local().drain(); }
+
+  private:
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  // 只有所属线程写入，其他线程在 globalStats() 中读取，所以用 relaxed 原子变量而不是锁
+  struct Counters {
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> releases{0};
+    std::atomic<uint64_t> freed{0};
+    std::atomic<uint64_t> cached{0};
+    std::atomic<uint64_t> highWater{0};
+
+    [[nodiscard]] auto snapshot() const -> PoolStats {
+      PoolStats stats;
+      stats.hits      = hits.load(std::memory_order_relaxed);
+      stats.misses    = misses.load(std::memory_order_relaxed);
+      stats.releases  = releases.load(std::memory_order_relaxed);
+      stats.freed     = freed.load(std::memory_order_relaxed);
+      stats.cached    = cached.load(std::memory_order_relaxed);
+      stats.highWater = highWater.load(std::memory_order_relaxed);
+      return stats;
+    }
+  };
+
+  struct LocalCache;
+
+  struct Registry {
+    std::mutex               mutex;
+    std::vector<LocalCache*> caches;
+    PoolStats                retired;   // 已退出线程的累计统计
+  };
+
+  struct LocalCache {
+    FreeNode* head   = nullptr;
+    size_t    length = 0;
+    Counters  counters;
+
+    LocalCache() {
+      Registry&                   reg = registry();
+      std::lock_guard<std::mutex> lock(reg.mutex);
+      reg.caches.push_back(this);
+    }
+
+    ~LocalCache() {
+      drain();
+      Registry&                   reg = registry();
+      std::lock_guard<std::mutex> lock(reg.mutex);
+      reg.retired += counters.snapshot();
+      reg.caches.erase(std::find(reg.caches.begin(), reg.caches.end(), this));
+    }
+
+    void drain() noexcept {
+      while (head != nullptr) {
+        FreeNode* next = head->next;
+        ::operator delete(head);
+        head = next;
+        bump(counters.freed);
+      }
+      length = 0;
+      counters.cached.store(0, std::memory_order_relaxed);
+    }
+  };
+
+  // 单写者计数：不需要 fetch_add 的 lock 前缀
+  static void bump(std::atomic<uint64_t>& counter) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  static auto registry() -> Registry& {
+    static Registry reg;
+    return reg;
+  }
+
+  static auto local() -> LocalCache& {
+    thread_local LocalCache cache;
+    return cache;
+  }
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef __COUNTED_RATIONAL__H
+#define __COUNTED_RATIONAL__H
+
+/**
+ * @file counted_rational.h
+ * @brief 条款 21 中演示返回值的 Rational，用 LifecycleCounted 统计对象的创建和销毁
+ *
+ * 原来的 Rational 在构造、拷贝和析构时打印日志。现在不写特殊成员函数，由基类计数
+ * （编译器生成的拷贝、移动构造函数会调用基类的对应版本），可以用 LifecycleScope<Rational>
+ * 检查 a * b 产生了多少个对象。
+ */
+
+#include <iostream>
+#include <type_traits>
+
+#include "lifecycle_counter.h"
+
+class Rational : private LifecycleCounted<Rational> {
+  public:
+  // 构造函数不声明为explicit，允许隐式转换
+  Rational(int numerator = 0, int denominator = 1)
+    : n(numerator)
+    , d(denominator) {}
+
+  // 打印函数
+  void print() const { std::cout << n << "/" << d; }
+
+  private:
+  int n, d;   // 分子(numerator)和分母(denominator)
+
+  // 声明为友元，允许访问私有成员
+  friend auto operator*(const Rational& lhs, const Rational& rhs) -> const Rational;
+  friend auto badMultiplyStack(const Rational& lhs, const Rational& rhs) -> const Rational&;
+  friend auto badMultiplyHeap(const Rational& lhs, const Rational& rhs) -> const Rational&;
+};
+
+// 关闭计数时 Rational 与两个 int 的结构体一样可以平凡拷贝、平凡析构
+static_assert(kLifecycleCountersEnabled || std::is_trivially_copyable_v<Rational>);
+
+// 正确实现：返回一个新对象。返回的是纯右值，C++17 保证直接构造在调用方，只构造一次
+inline auto operator*(const Rational& lhs, const Rational& rhs) -> const Rational {
+  return Rational(lhs.n * rhs.n, lhs.d * rhs.d);
+}
+
+#endif
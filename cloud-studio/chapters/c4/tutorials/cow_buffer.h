@@ -0,0 +1,153 @@
+#ifndef __COW_BUFFER__H
+#define __COW_BUFFER__H
+
+/**
+ * @file cow_buffer.h
+ * @brief 写时复制（copy-on-write）的引用计数缓冲区
+ *
+ * 条款14 中资源管理类的第三种拷贝策略：引用计数。
+ * - 拷贝只增加引用计数，多个对象共享同一块内存
+ * - 第一次通过非 const 的 operator[] / data() 访问时，如果内存被共享，就克隆一份（detach）
+ * - 交出可写引用后缓冲区被标记为"不可共享"，之后的拷贝退化为深拷贝，
+ *   避免之前拿到的指针写到新副本上
+ * - 引用计数是原子的，多个线程可以同时读取、拷贝同一个 const 对象
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+template<typename T> class CowBuffer {
+  static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned element types unsupported");
+
+  public:
+  CowBuffer() = default;
+
+  // 元素做值初始化
+  explicit CowBuffer(size_t size)
+    : block_(allocate(size)) {
+    std::uninitialized_value_construct_n(elements(block_), size);
+  }
+
+  // 共享对方的内存块；对方交出过可写引用时只能深拷贝
+  CowBuffer(const CowBuffer& other) {
+    if (other.block_ == nullptr) {
+      return;
+    }
+    if (other.block_->unshareable) {
+      block_ = clone(other.block_);
+    }
+    else {
+      other.block_->refs.fetch_add(1, std::memory_order_relaxed);
+      block_ = other.block_;
+    }
+  }
+
+  CowBuffer(CowBuffer&& other) noexcept
+    : block_(std::exchange(other.block_, nullptr)) {}
+
+  auto operator=(CowBuffer other) noexcept -> CowBuffer& {
+    swap(other);
+    return *this;
+  }
+
+  ~CowBuffer() { release(block_); }
+
+  void swap(CowBuffer& other) noexcept { std::swap(block_, other.block_); }
+
+  [[nodiscard]] auto size() const -> size_t { return block_ == nullptr ? 0 : block_->size; }
+
+  // 只读访问：不会触发复制
+  [[nodiscard]] auto data() const -> const T* {
+    return block_ == nullptr ? nullptr : elements(block_);
+  }
+  [[nodiscard]] auto cdata() const -> const T* { return data(); }
+  auto operator[](size_t i) const -> const T& { return elements(block_)[i]; }
+
+  // 可写访问：先确保独占内存块，再交出引用
+  auto data() -> T* {
+    if (block_ == nullptr) {
+      return nullptr;
+    }
+    detach();
+    block_->unshareable = true;
+    return elements(block_);
+  }
+
+  auto operator[](size_t i) -> T& { return data()[i]; }
+
+  // 不交出引用的写操作，之后的拷贝仍然可以共享
+  void set(size_t i, const T& value) {
+    detach();
+    elements(block_)[i] = value;
+  }
+
+  // 与另一个缓冲区共享同一块内存时返回 true
+  [[nodiscard]] auto sharesDataWith(const CowBuffer& other) const -> bool {
+    return block_ != nullptr && block_ == other.block_;
+  }
+
+  [[nodiscard]] auto useCount() const -> size_t {
+    return block_ == nullptr ? 0 : block_->refs.load(std::memory_order_acquire);
+  }
+
+  private:
+  struct Block {
+    std::atomic<size_t> refs{1};
+    size_t              size        = 0;
+    bool                unshareable = false;
+  };
+
+  // 控制块和元素放在同一次分配中，元素紧跟在控制块之后
+  static constexpr size_t kHeaderBytes = (sizeof(Block) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+  static auto elements(Block* block) -> T* {
+    return std::launder(reinterpret_cast<T*>(reinterpret_cast<char*>(block) + kHeaderBytes));
+  }
+
+  static auto allocate(size_t size) -> Block* {
+    void* raw   = ::operator new(kHeaderBytes + size * sizeof(T));
+    auto* block = new (raw) Block();
+    block->size = size;
+    return block;
+  }
+
+  static void deallocate(Block* block) {
+    block->~Block();
+    ::operator delete(static_cast<void*>(block));
+  }
+
+  static auto clone(const Block* source) -> Block* {
+    Block* block = allocate(source->size);
+    try {
+      std::uninitialized_copy_n(elements(const_cast<Block*>(source)), source->size, elements(block));
+    } catch (...) {
+      deallocate(block);
+      throw;
+    }
+    return block;
+  }
+
+  static void release(Block* block) noexcept {
+    if (block != nullptr && block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::destroy_n(elements(block), block->size);
+      deallocate(block);
+    }
+  }
+
+  // 被共享时克隆一份，之后当前对象独占内存块
+  void detach() {
+    if (block_->refs.load(std::memory_order_acquire) > 1) {
+      Block* fresh = clone(block_);
+      release(block_);
+      block_ = fresh;
+    }
+  }
+
+  Block* block_ = nullptr;
+};
+
+#endif
@@ -0,0 +1,260 @@
+#ifndef __GARAGE__H
+#define __GARAGE__H
+
+/**
+ * @file garage.h
+ * @brief 条款 19 中演示继承关系的 Vehicle / Car / Garage
+ *
+ * Garage 有两种存放车辆的方式：
+ * - addVehicle(std::unique_ptr<Vehicle>)：每辆车单独分配在堆上，适合只有基类指针的调用方
+ * - emplaceVehicle<T>(args...)：按具体类型分段连续存放（见 poly_collection.h），
+ *   startAllVehicles() 逐段遍历，同一段内的虚函数调用目标相同；
+ *   startAllVehicles<T1, T2, ...>() 对列出的 final 类型直接调用，不经过虚函数表
+ *
+ * startAllVehicles() 逐辆同步启动。启动需要等待外部设备（类似 I/O）时，startAll() / stopAll()
+ * 把车辆分给至多 FleetOptions::concurrency 个工作线程异步执行，立即返回 FleetOperation：
+ * 可以查询每辆车的完成状态、整体进度和延迟直方图，wait() 等待全部完成。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "latency_histogram.h"
+#include "poly_collection.h"
+
+/**
+ * @brief 演示继承关系的基类
+ * 展示：
+ * - 虚函数
+ * - 纯虚函数
+ * - protected成员
+ */
+class Vehicle {
+  public:
+  virtual ~Vehicle() = default;   // 虚析构函数
+
+  // 纯虚函数：定义接口
+  virtual void start() = 0;
+  virtual void stop()  = 0;
+
+  // 虚函数：可以被重写
+  virtual void accelerate() { std::cout << "Vehicle加速" << std::endl; }
+
+  // 非虚函数：不应被重写
+  void park() { std::cout << "Vehicle停车" << std::endl; }
+
+  [[nodiscard]] auto isRunning() const -> bool { return engineRunning_; }
+
+  protected:
+  // 保护成员：派生类可访问
+  bool engineRunning_ = false;
+};
+
+/**
+ * @brief 演示"is-a"关系的派生类
+ * Car "is-a" Vehicle
+ */
+class Car : public Vehicle {
+  public:
+  // 实现纯虚函数
+  void start() override {
+    std::cout << "Car启动" << std::endl;
+    engineRunning_ = true;
+  }
+
+  void stop() override {
+    std::cout << "Car停止" << std::endl;
+    engineRunning_ = false;
+  }
+
+  // 重写虚函数
+  void accelerate() override { std::cout << "Car加速" << std::endl; }
+};
+
+struct FleetOptions {
+  size_t concurrency = 16;   // 同时执行的车辆数上限，也是工作线程数
+};
+
+enum class VehicleOpStatus : uint8_t
+{
+  Pending,   // 还没有轮到（值为 0，值初始化的状态数组都是 Pending）
+  Running,   // 正在执行
+  Done,      // 成功完成
+  Failed,    // 抛出了异常
+};
+
+/**
+ * @brief 一次异步的批量 start() / stop()
+ *
+ * 工作线程从共享的下标中领取下一辆车，执行完记录状态和耗时，直到所有车辆处理完。
+ * 每个工作线程使用自己的 LatencyHistogram，wait() 之后合并。
+ * 操作进行期间，Garage 及其中的车辆不能被修改或销毁；析构时等待所有车辆处理完。
+ */
+class FleetOperation {
+  public:
+  using Action = void (Vehicle::*)();
+
+  FleetOperation(std::vector<Vehicle*> vehicles, Action action, const FleetOptions& options)
+    : vehicles_(std::move(vehicles))
+    , action_(action)
+    , statuses_(std::make_unique<std::atomic<VehicleOpStatus>[]>(vehicles_.size())) {
+    const size_t workers = std::min(std::max<size_t>(options.concurrency, 1), vehicles_.size());
+    workerLatencies_.resize(workers);
+    workers_.reserve(workers);
+    try {
+      for (size_t w = 0; w < workers; ++w) {
+        workers_.emplace_back([this, w] { run(workerLatencies_[w]); });
+      }
+    } catch (...) {
+      // 创建线程失败：已经启动的线程会处理完所有车辆，等它们结束后再报告错误
+      wait();
+      throw;
+    }
+  }
+
+  ~FleetOperation() { wait(); }
+
+  // 工作线程持有 this，不能拷贝或移动；Garage::startAll() 返回的临时对象直接构造在调用方
+  FleetOperation(const FleetOperation&)                    = delete;
+  auto operator=(const FleetOperation&) -> FleetOperation& = delete;
+
+  // 等待所有车辆处理完；只能由持有者所在的线程调用
+  void wait() {
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+    workers_.clear();
+    for (const auto& latencies : workerLatencies_) {
+      latencies_.merge(latencies);
+    }
+    workerLatencies_.clear();
+  }
+
+  [[nodiscard]] auto total() const -> size_t { return vehicles_.size(); }
+  [[nodiscard]] auto completed() const -> size_t {
+    return completed_.load(std::memory_order_acquire);
+  }
+  [[nodiscard]] auto failed() const -> size_t { return failed_.load(std::memory_order_acquire); }
+  [[nodiscard]] auto done() const -> bool { return completed() + failed() == total(); }
+
+  // 第 i 辆车（按 Garage 的遍历顺序）的状态
+  [[nodiscard]] auto status(size_t i) const -> VehicleOpStatus {
+    return statuses_[i].load(std::memory_order_acquire);
+  }
+  [[nodiscard]] auto vehicle(size_t i) const -> const Vehicle& { return *vehicles_[i]; }
+
+  // 每辆车的耗时分布；wait() 之后才包含全部样本
+  [[nodiscard]] auto latencies() const -> const LatencyHistogram& { return latencies_; }
+
+  // 第一个失败的车辆抛出的异常；没有失败时为空
+  [[nodiscard]] auto firstError() const -> std::exception_ptr {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    return firstError_;
+  }
+
+  private:
+  std::vector<Vehicle*>                           vehicles_;
+  Action                                          action_;
+  std::unique_ptr<std::atomic<VehicleOpStatus>[]> statuses_;
+  std::atomic<size_t>                             next_{0};
+  std::atomic<size_t>                             completed_{0};
+  std::atomic<size_t>                             failed_{0};
+  mutable std::mutex                              errorMutex_;
+  std::exception_ptr                              firstError_;
+  std::vector<LatencyHistogram>                   workerLatencies_;
+  LatencyHistogram                                latencies_;
+  std::vector<std::thread>                        workers_;   // 最后声明：构造时其余成员都已就绪
+
+  void run(LatencyHistogram& latencies) {
+    for (size_t i = next_.fetch_add(1, std::memory_order_relaxed); i < vehicles_.size();
+         i = next_.fetch_add(1, std::memory_order_relaxed)) {
+      statuses_[i].store(VehicleOpStatus::Running, std::memory_order_relaxed);
+      const auto start = std::chrono::steady_clock::now();
+      try {
+        (vehicles_[i]->*action_)();
+        statuses_[i].store(VehicleOpStatus::Done, std::memory_order_release);
+        completed_.fetch_add(1, std::memory_order_release);
+      } catch (...) {
+        {
+          std::lock_guard<std::mutex> lock(errorMutex_);
+          if (!firstError_) {
+            firstError_ = std::current_exception();
+          }
+        }
+        statuses_[i].store(VehicleOpStatus::Failed, std::memory_order_release);
+        failed_.fetch_add(1, std::memory_order_release);
+      }
+      latencies.record(std::chrono::steady_clock::now() - start);
+    }
+  }
+};
+
+/**
+ * @brief 演示"has-a"关系的类
+ * Garage有多个Vehicle
+ */
+class Garage {
+  public:
+  // 添加车辆
+  void addVehicle(std::unique_ptr<Vehicle> vehicle) { vehicles_.push_back(std::move(vehicle)); }
+
+  // 在 T 的段中就地构造车辆；返回的引用在下一次添加同类车辆之前有效
+  template<typename T, typename... Args> auto emplaceVehicle(Args&&... args) -> T& {
+    return fleet_.emplace<T>(std::forward<Args>(args)...);
+  }
+
+  template<typename T> void reserveVehicles(size_t count) { fleet_.reserve<T>(count); }
+
+  [[nodiscard]] auto vehicleCount() const -> size_t { return vehicles_.size() + fleet_.size(); }
+
+  // 启动所有车辆
+  void startAllVehicles() {
+    for (const auto& vehicle : vehicles_) {
+      vehicle->start();   // 多态调用
+    }
+    fleet_.forEach([](Vehicle& vehicle) { vehicle.start(); });   // 逐段调用，目标可预测
+  }
+
+  // Kinds 中的类型按静态类型调用 start()；Kinds 是 final 类时调用被去虚化
+  template<typename... Kinds> void startAllVehicles() {
+    for (const auto& vehicle : vehicles_) {
+      vehicle->start();
+    }
+    fleet_.forEach<Kinds...>([](auto& vehicle) { vehicle.start(); });
+  }
+
+  // 异步启动 / 停止所有车辆，至多 options.concurrency 辆同时进行；Garage 必须比返回值活得久
+  [[nodiscard]] auto startAll(const FleetOptions& options = {}) -> FleetOperation {
+    return FleetOperation(snapshot(), &Vehicle::start, options);
+  }
+  [[nodiscard]] auto stopAll(const FleetOptions& options = {}) -> FleetOperation {
+    return FleetOperation(snapshot(), &Vehicle::stop, options);
+  }
+
+  private:
+  std::vector<std::unique_ptr<Vehicle>> vehicles_;   // has-a关系
+  PolyCollection<Vehicle>               fleet_;      // 按具体类型分段连续存放
+
+  // 与 startAllVehicles() 相同的顺序：先是单独分配的车辆，再逐段遍历
+  [[nodiscard]] auto snapshot() -> std::vector<Vehicle*> {
+    std::vector<Vehicle*> all;
+    all.reserve(vehicleCount());
+    for (const auto& vehicle : vehicles_) {
+      all.push_back(vehicle.get());
+    }
+    fleet_.forEach([&all](Vehicle& vehicle) { all.push_back(&vehicle); });
+    return all;
+  }
+};
+
+#endif
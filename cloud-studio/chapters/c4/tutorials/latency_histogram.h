@@ -0,0 +1,97 @@
+#ifndef __LATENCY_HISTOGRAM__H
+#define __LATENCY_HISTOGRAM__H
+
+/**
+ * @file latency_histogram.h
+ * @brief 固定内存的延迟直方图
+ *
+ * 保存每个样本再排序求百分位数，内存随样本数增长；LatencyHistogram 只保存计数：
+ * 小于 16 ns 的值各占一个桶，之后每个 2 的幂区间均分成 16 个桶，
+ * 相对误差不超过 1/16，覆盖完整的 uint64_t 纳秒范围，总共约 1000 个桶（8 KB）。
+ * 记录一次样本只是一次桶下标计算和一次加法；不加锁，每个线程各用一个，结束后 merge()。
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+class LatencyHistogram {
+  public:
+  void record(uint64_t nanoseconds) {
+    ++buckets_[bucketOf(nanoseconds)];
+    ++count_;
+    sum_ += nanoseconds;
+    max_ = std::max(max_, nanoseconds);
+  }
+
+  template<typename Rep, typename Period> void record(std::chrono::duration<Rep, Period> latency) {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+    record(ns < 0 ? uint64_t{0} : static_cast<uint64_t>(ns));
+  }
+
+  void merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBuckets; ++i) {
+      buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  [[nodiscard]] auto count() const -> uint64_t { return count_; }
+  [[nodiscard]] auto max() const -> uint64_t { return max_; }
+  [[nodiscard]] auto mean() const -> double {
+    return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+  }
+
+  // 第 p（0 ~ 1）分位数，返回所在桶的上界（不超过 max()）；没有样本时返回 0
+  [[nodiscard]] auto percentile(double p) const -> uint64_t {
+    if (count_ == 0) {
+      return 0;
+    }
+    const double clamped = std::min(std::max(p, 0.0), 1.0);
+    const auto   rank    = std::max<uint64_t>(1, static_cast<uint64_t>(clamped * count_ + 0.5));
+    uint64_t     seen    = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+      seen += buckets_[i];
+      if (seen >= rank) {
+        return std::min(upperBound(i), max_);
+      }
+    }
+    return max_;
+  }
+
+  private:
+  static constexpr unsigned kSubBits = 4;   // 每个 2 的幂区间分成 2^4 个桶
+  static constexpr uint64_t kSub     = uint64_t{1} << kSubBits;
+  static constexpr size_t   kBuckets = (64 - kSubBits + 1) * kSub;
+
+  std::array<uint64_t, kBuckets> buckets_{};
+  uint64_t                       count_ = 0;
+  uint64_t                       sum_   = 0;
+  uint64_t                       max_   = 0;
+
+  static auto bucketOf(uint64_t value) -> size_t {
+    if (value < kSub) {
+      return static_cast<size_t>(value);
+    }
+    const unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(value));   // >= kSubBits
+    const uint64_t mantissa = (value >> (exponent - kSubBits)) & (kSub - 1);
+    return static_cast<size_t>((exponent - kSubBits + 1) * kSub + mantissa);
+  }
+
+  // 桶中最大的值
+  static auto upperBound(size_t bucket) -> uint64_t {
+    if (bucket < kSub) {
+      return bucket;
+    }
+    const uint64_t exponent = bucket / kSub + kSubBits - 1;
+    const uint64_t mantissa = bucket % kSub;
+    const uint64_t width    = uint64_t{1} << (exponent - kSubBits);
+    return ((kSub + mantissa) << (exponent - kSubBits)) + (width - 1);
+  }
+};
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef __LIFECYCLE_COUNTER__H
+#define __LIFECYCLE_COUNTER__H
+
+/**
+ * @file lifecycle_counter.h
+ * @brief 按类型统计对象的构造、拷贝、移动和析构次数，代替在特殊成员函数里打印
+ *
+ * 在构造函数、析构函数里输出日志可以看出临时对象的产生，但真实负载下 I/O 成了瓶颈，
+ * 日志也很难断言。这里改为计数：
+ * - 类 T 私有继承 LifecycleCounted<T>，不需要自己写特殊成员函数；
+ *   每个类型有自己的一组计数器（relaxed 原子变量，多线程下也准确）
+ * - LifecycleScope<T> 在创建时记录快照，diff() 返回此后的变化量，便于在测试里断言
+ *   "a * b 只构造了一个对象"
+ * - 编译时定义 LIFECYCLE_COUNTERS=0 关闭计数：LifecycleCounted<T> 是没有任何成员函数的空基类，
+ *   T 的特殊成员函数保持平凡，不产生任何额外指令；计数器始终为 0
+ */
+
+#include <atomic>
+#include <cstdint>
+
+#ifndef LIFECYCLE_COUNTERS
+#define LIFECYCLE_COUNTERS 1
+#endif
+
+struct LifecycleCounts {
+  uint64_t constructed = 0;   // 除拷贝、移动以外的构造
+  uint64_t copied      = 0;   // 拷贝构造
+  uint64_t moved       = 0;   // 移动构造
+  uint64_t destroyed   = 0;
+
+  // 仍然存活的对象数；两次快照之差可能为负
+  [[nodiscard]] auto live() const -> int64_t {
+    return static_cast<int64_t>(constructed + copied + moved - destroyed);
+  }
+};
+
+inline auto operator-(const LifecycleCounts& lhs, const LifecycleCounts& rhs) -> LifecycleCounts {
+  return {lhs.constructed - rhs.constructed,
+          lhs.copied - rhs.copied,
+          lhs.moved - rhs.moved,
+          lhs.destroyed - rhs.destroyed};
+}
+
+inline auto operator==(const LifecycleCounts& lhs, const LifecycleCounts& rhs) -> bool {
+  return lhs.constructed == rhs.constructed && lhs.copied == rhs.copied &&
+         lhs.moved == rhs.moved && lhs.destroyed == rhs.destroyed;
+}
+
+namespace lifecycle_detail {
+
+// 每个类型一组计数器
+template<typename T> struct Counters {
+  static inline std::atomic<uint64_t> constructed{0};
+  static inline std::atomic<uint64_t> copied{0};
+  static inline std::atomic<uint64_t> moved{0};
+  static inline std::atomic<uint64_t> destroyed{0};
+
+  static void bump(std::atomic<uint64_t>& counter) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+}   // namespace lifecycle_detail
+
+constexpr bool kLifecycleCountersEnabled = LIFECYCLE_COUNTERS != 0;
+
+// T 的累计计数；关闭计数时始终为 0
+template<typename T> auto lifecycleCounts() -> LifecycleCounts {
+  using C = lifecycle_detail::Counters<T>;
+  return {C::constructed.load(std::memory_order_relaxed),
+          C::copied.load(std::memory_order_relaxed),
+          C::moved.load(std::memory_order_relaxed),
+          C::destroyed.load(std::memory_order_relaxed)};
+}
+
+#if LIFECYCLE_COUNTERS
+
+/**
+ * @brief 计数用的 CRTP 基类：class T : private LifecycleCounted<T>
+ *
+ * 赋值不创建新对象，沿用默认实现，不计数。
+ */
+template<typename T> class LifecycleCounted {
+  protected:
+  LifecycleCounted() { C::bump(C::constructed); }
+  LifecycleCounted(const LifecycleCounted&) { C::bump(C::copied); }
+  LifecycleCounted(LifecycleCounted&&) noexcept { C::bump(C::moved); }
+  ~LifecycleCounted() { C::bump(C::destroyed); }
+  auto operator=(const LifecycleCounted&) -> LifecycleCounted& = default;
+  auto operator=(LifecycleCounted&&) noexcept -> LifecycleCounted& = default;
+
+  private:
+  using C = lifecycle_detail::Counters<T>;
+};
+
+#else
+
+template<typename T> class LifecycleCounted {};
+
+#endif
+
+/**
+ * @brief 记录创建时 T 的计数，diff() 返回此后的变化量
+ *
+ * 计数器是全局的：其他线程同时创建或销毁 T 时，变化量也包含它们的操作。
+ */
+template<typename T> class LifecycleScope {
+  public:
+  LifecycleScope()
+    : start_(lifecycleCounts<T>()) {}
+
+  [[nodiscard]] auto diff() const -> LifecycleCounts { return lifecycleCounts<T>() - start_; }
+
+  private:
+  LifecycleCounts start_;
+};
+
+#endif
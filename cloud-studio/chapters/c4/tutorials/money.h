@@ -0,0 +1,282 @@
+#ifndef __MONEY__H
+#define __MONEY__H
+
+/**
+ * @file money.h
+ * @brief 定点金额类型：以分为单位的 64 位整数
+ *
+ * double 无法精确表示 0.1 元，反复加减会累积舍入误差，余额也没法用整数 SIMD 批量处理。
+ * Money 只包含一个 int64_t（分）：
+ * - 加、减、乘都是 constexpr，溢出时抛出 std::overflow_error；tryAdd / trySub 不抛异常
+ * - withRate(basisPoints) 按万分比调整金额（奖金、利率），四舍五入到分，中间结果用 128 位整数
+ * - sizeof(Money) == sizeof(int64_t)，Money 数组就是 int64_t 数组，
+ *   money::sum / money::addAll 按 8 个通道累加并检测溢出，编译器可以向量化
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+class Money {
+  public:
+  static constexpr int64_t kMinorPerUnit = 100;   // 1 元 = 100 分
+  static constexpr int64_t kRateScale    = 10'000;   // 1 个基点 = 0.01%
+
+  constexpr Money() = default;
+
+  [[nodiscard]] static constexpr auto fromMinor(int64_t minor) -> Money { return Money(minor); }
+
+  [[nodiscard]] static constexpr auto units(int64_t units) -> Money {
+    return Money(checkedMul(units, kMinorPerUnit));
+  }
+
+  // 四舍五入到分；NaN 或超出范围时抛出 std::invalid_argument / std::overflow_error
+  [[nodiscard]] static auto fromDouble(double amount) -> Money {
+    if (std::isnan(amount)) {
+      throw std::invalid_argument("Money: NaN amount");
+    }
+    const double minor = std::round(amount * kMinorPerUnit);
+    // 2^63 可以精确表示为 double，[-2^63, 2^63) 之内的值都能转换
+    if (minor < -9223372036854775808.0 || minor >= 9223372036854775808.0) {
+      throw std::overflow_error("Money: amount out of range");
+    }
+    return Money(static_cast<int64_t>(minor));
+  }
+
+  [[nodiscard]] constexpr auto minor() const -> int64_t { return minor_; }
+  [[nodiscard]] auto toDouble() const -> double {
+    return static_cast<double>(minor_) / kMinorPerUnit;
+  }
+
+  [[nodiscard]] constexpr auto isNegative() const -> bool { return minor_ < 0; }
+  [[nodiscard]] constexpr auto isPositive() const -> bool { return minor_ > 0; }
+
+  // 不抛异常的加减：溢出时返回 false，out 不变
+  [[nodiscard]] static constexpr auto tryAdd(Money a, Money b, Money& out) noexcept -> bool {
+    int64_t result = 0;
+    if (__builtin_add_overflow(a.minor_, b.minor_, &result)) {
+      return false;
+    }
+    out = Money(result);
+    return true;
+  }
+
+  [[nodiscard]] static constexpr auto trySub(Money a, Money b, Money& out) noexcept -> bool {
+    int64_t result = 0;
+    if (__builtin_sub_overflow(a.minor_, b.minor_, &result)) {
+      return false;
+    }
+    out = Money(result);
+    return true;
+  }
+
+  friend constexpr auto operator+(Money a, Money b) -> Money {
+    Money result;
+    if (!tryAdd(a, b, result)) {
+      throw std::overflow_error("Money: addition overflow");
+    }
+    return result;
+  }
+
+  friend constexpr auto operator-(Money a, Money b) -> Money {
+    Money result;
+    if (!trySub(a, b, result)) {
+      throw std::overflow_error("Money: subtraction overflow");
+    }
+    return result;
+  }
+
+  constexpr auto operator-() const -> Money { return Money() - *this; }
+
+  constexpr auto operator+=(Money other) -> Money& { return *this = *this + other; }
+  constexpr auto operator-=(Money other) -> Money& { return *this = *this - other; }
+
+  friend constexpr auto operator*(Money a, int64_t factor) -> Money {
+    return Money(checkedMul(a.minor_, factor));
+  }
+  friend constexpr auto operator*(int64_t factor, Money a) -> Money { return a * factor; }
+
+  /**
+   * 按万分比调整：withRate(1'000) 表示增加 10%，withRate(-500) 表示减少 5%
+   * 结果按“四舍五入、远离零”取整到分
+   */
+  [[nodiscard]] constexpr auto withRate(int64_t basisPoints) const -> Money {
+    int64_t multiplier = 0;
+    if (__builtin_add_overflow(kRateScale, basisPoints, &multiplier)) {
+      throw std::overflow_error("Money: rate overflow");
+    }
+    return scaled(multiplier, kRateScale);
+  }
+
+  // minor * numerator / denominator，四舍五入（远离零）；denominator 必须为正
+  [[nodiscard]] constexpr auto scaled(int64_t numerator, int64_t denominator) const -> Money {
+    if (denominator <= 0) {
+      throw std::invalid_argument("Money: denominator must be positive");
+    }
+    const __int128 product = static_cast<__int128>(minor_) * numerator;
+    const __int128 half    = denominator / 2;
+    const __int128 result  = product >= 0 ? (product + half) / denominator
+                                          : (product - half) / denominator;
+    if (result > INT64_MAX || result < INT64_MIN) {
+      throw std::overflow_error("Money: scaling overflow");
+    }
+    return Money(static_cast<int64_t>(result));
+  }
+
+  friend constexpr auto operator==(Money a, Money b) -> bool { return a.minor_ == b.minor_; }
+  friend constexpr auto operator!=(Money a, Money b) -> bool { return a.minor_ != b.minor_; }
+  friend constexpr auto operator<(Money a, Money b) -> bool { return a.minor_ < b.minor_; }
+  friend constexpr auto operator<=(Money a, Money b) -> bool { return a.minor_ <= b.minor_; }
+  friend constexpr auto operator>(Money a, Money b) -> bool { return a.minor_ > b.minor_; }
+  friend constexpr auto operator>=(Money a, Money b) -> bool { return a.minor_ >= b.minor_; }
+
+  // 输出为“元.分”，例如 -12.05
+  friend auto operator<<(std::ostream& os, Money money) -> std::ostream& {
+    const uint64_t abs = magnitude(money.minor_);
+    if (money.minor_ < 0) {
+      os << '-';
+    }
+    const char fill = os.fill('0');
+    os << abs / kMinorPerUnit << '.' << std::setw(2) << abs % kMinorPerUnit;
+    os.fill(fill);
+    return os;
+  }
+
+  private:
+  int64_t minor_ = 0;
+
+  explicit constexpr Money(int64_t minor)
+    : minor_(minor) {}
+
+  static constexpr auto magnitude(int64_t x) -> uint64_t {
+    return x < 0 ? 0 - static_cast<uint64_t>(x) : static_cast<uint64_t>(x);
+  }
+
+  static constexpr auto checkedMul(int64_t a, int64_t b) -> int64_t {
+    int64_t result = 0;
+    if (__builtin_mul_overflow(a, b, &result)) {
+      throw std::overflow_error("Money: multiplication overflow");
+    }
+    return result;
+  }
+};
+
+static_assert(sizeof(Money) == sizeof(int64_t), "Money arrays must be plain int64_t arrays");
+static_assert(std::is_trivially_copyable_v<Money>, "Money must be trivially copyable");
+
+namespace money {
+
+// 有符号加法溢出当且仅当两个加数同号且和的符号与它们不同；用无符号加法避免未定义行为
+constexpr auto wrappingAdd(int64_t a, int64_t b) -> int64_t {
+  return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+}
+constexpr auto overflowBits(int64_t a, int64_t b, int64_t sum) -> int64_t {
+  return (a ^ sum) & (b ^ sum);
+}
+
+constexpr size_t kLanes     = 8;     // 8 个独立的累加器，AVX2 两条、AVX-512 一条指令
+constexpr size_t kRateBlock = 256;   // applyRate() 每次检查溢出的元素个数
+
+// 求和；溢出时抛出 std::overflow_error
+inline auto sum(const Money* values, size_t count) -> Money {
+  int64_t acc[kLanes]      = {};
+  int64_t overflow[kLanes] = {};
+  size_t  i                = 0;
+  for (; i + kLanes <= count; i += kLanes) {
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      const int64_t x = values[i + lane].minor();
+      const int64_t s = wrappingAdd(acc[lane], x);
+      overflow[lane] |= overflowBits(acc[lane], x, s);
+      acc[lane] = s;
+    }
+  }
+  int64_t anyOverflow = 0;
+  for (size_t lane = 0; lane < kLanes; ++lane) {
+    anyOverflow |= overflow[lane];
+  }
+  if (anyOverflow < 0) {
+    throw std::overflow_error("Money: sum overflow");
+  }
+  // 各通道的部分和以及剩余元素用带检查的加法合并
+  Money total;
+  for (size_t lane = 0; lane < kLanes; ++lane) {
+    total += Money::fromMinor(acc[lane]);
+  }
+  for (; i < count; ++i) {
+    total += values[i];
+  }
+  return total;
+}
+
+/**
+ * balances[i] += deltas[i]（例如一批存款）
+ * 任何一个元素溢出时抛出 std::overflow_error，此时 balances 保持不变
+ */
+inline void addAll(Money* balances, const Money* deltas, size_t count) {
+  // 一遍完成回绕加法和溢出检测（可以向量化）；溢出很少发生，发生时再减回去
+  int64_t anyOverflow = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const int64_t a = balances[i].minor();
+    const int64_t b = deltas[i].minor();
+    const int64_t s = wrappingAdd(a, b);
+    anyOverflow |= overflowBits(a, b, s);
+    balances[i] = Money::fromMinor(s);
+  }
+  if (anyOverflow < 0) {
+    // 回绕加法可逆：减去同样的值就能精确恢复原来的余额
+    for (size_t i = 0; i < count; ++i) {
+      balances[i] = Money::fromMinor(wrappingAdd(balances[i].minor(), 0 - deltas[i].minor()));
+    }
+    throw std::overflow_error("Money: addition overflow");
+  }
+}
+
+/**
+ * out[i] = values[i].withRate(basisPoints)（例如给一批工资加上奖金）
+ * x86 没有 64 位整数乘法和除法的向量指令（AVX2 只有 32 位），这里是 64 位的标量循环：
+ * 乘积和舍入在 64 位内完成时只需一次乘法、一次加法和一次“除以常数”（编译成乘法和移位），
+ * 每 kRateBlock 个元素检查一次溢出标志；极少数超出 64 位的块改用 withRate() 的 128 位路径。
+ * 这时 out 中的这一块已经写过，所以原地调整（out == values）时先把每一块的原值复制到栈上，
+ * 否则同一个比率会被应用两次；除此之外 out 与 values 不能重叠。
+ * 结果真正超出范围时抛出 std::overflow_error，此前的块已经写入 out
+ */
+inline void applyRate(const Money* values, Money* out, size_t count, int64_t basisPoints) {
+  constexpr int64_t half       = Money::kRateScale / 2;
+  int64_t           multiplier = 0;
+  if (__builtin_add_overflow(Money::kRateScale, basisPoints, &multiplier)) {
+    throw std::overflow_error("Money: rate overflow");
+  }
+  const bool inPlace = values == out;
+  Money      saved[kRateBlock];
+  for (size_t base = 0; base < count; base += kRateBlock) {
+    const size_t len = std::min(kRateBlock, count - base);
+    const Money* in  = values + base;
+    if (inPlace) {
+      std::copy(in, in + len, saved);
+      in = saved;
+    }
+    bool overflow = false;
+    for (size_t i = 0; i < len; ++i) {
+      int64_t product = 0;
+      overflow |= __builtin_mul_overflow(in[i].minor(), multiplier, &product);
+      overflow |= __builtin_add_overflow(product, product >= 0 ? half : -half, &product);
+      out[base + i] = Money::fromMinor(product / Money::kRateScale);
+    }
+    if (overflow) {
+      // 逐个用 128 位中间结果重新计算
+      for (size_t i = 0; i < len; ++i) {
+        out[base + i] = in[i].withRate(basisPoints);
+      }
+    }
+  }
+}
+
+}   // namespace money
+
+#endif
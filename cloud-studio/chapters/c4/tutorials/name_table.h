@@ -0,0 +1,145 @@
+#ifndef __NAME_TABLE__H
+#define __NAME_TABLE__H
+
+/**
+ * @file name_table.h
+ * @brief 字符串驻留（interning）：相同的名字只保存一份，对象里只存 32 位编号
+ *
+ * - NameTable::intern() 第一次见到某个名字时把字符拷进 arena（按块分配、只增不减），
+ *   之后返回同一个 Symbol；已经驻留的名字再次 intern 不分配内存
+ * - Symbol 只有一个 uint32_t，拷贝、移动、比较都是整数操作
+ * - 编号 0 固定表示空字符串，默认构造的 Symbol 不需要访问名字表
+ * - 名字表是进程级的，驻留的名字在程序结束前不会释放，只适合数量有限的名字
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class Symbol {
+  public:
+  constexpr Symbol() = default;
+
+  [[nodiscard]] constexpr auto id() const -> uint32_t { return id_; }
+  [[nodiscard]] constexpr auto empty() const -> bool { return id_ == 0; }
+
+  // 返回的 string_view 指向 arena，在程序结束前一直有效
+  [[nodiscard]] auto view() const -> std::string_view;
+
+  friend constexpr auto operator==(Symbol a, Symbol b) -> bool { return a.id_ == b.id_; }
+  friend constexpr auto operator!=(Symbol a, Symbol b) -> bool { return a.id_ != b.id_; }
+  // 按编号（驻留顺序）排序，不是字典序
+  friend constexpr auto operator<(Symbol a, Symbol b) -> bool { return a.id_ < b.id_; }
+
+  friend auto operator<<(std::ostream& os, Symbol symbol) -> std::ostream& {
+    return os << symbol.view();
+  }
+
+  private:
+  explicit constexpr Symbol(uint32_t id)
+    : id_(id) {}
+
+  uint32_t id_ = 0;
+
+  friend class NameTable;
+};
+
+class NameTable {
+  public:
+  static auto instance() -> NameTable& {
+    static NameTable table;
+    return table;
+  }
+
+  NameTable(const NameTable&)                    = delete;
+  auto operator=(const NameTable&) -> NameTable& = delete;
+
+  auto intern(std::string_view name) -> Symbol {
+    if (name.empty()) {
+      return Symbol();
+    }
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      auto                                it = index_.find(name);
+      if (it != index_.end()) {
+        return Symbol(it->second);
+      }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto                                it = index_.find(name);   // 可能已被其他线程插入
+    if (it != index_.end()) {
+      return Symbol(it->second);
+    }
+    if (names_.size() > UINT32_MAX) {
+      throw std::length_error("NameTable: too many symbols");
+    }
+    const std::string_view stored = store(name);
+    const auto             id     = static_cast<uint32_t>(names_.size());
+    names_.push_back(stored);
+    index_.emplace(stored, id);
+    return Symbol(id);
+  }
+
+  [[nodiscard]] auto lookup(Symbol symbol) const -> std::string_view {
+    if (symbol.empty()) {
+      return {};
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_[symbol.id_];
+  }
+
+  // 已驻留的名字个数（包括空字符串）
+  [[nodiscard]] auto size() const -> size_t {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+  }
+
+  // arena 已经向系统申请的字节数
+  [[nodiscard]] auto arenaBytes() const -> size_t {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return arenaBytes_;
+  }
+
+  private:
+  static constexpr size_t kChunkBytes = 64 * 1024;
+
+  mutable std::shared_mutex                      mutex_;
+  std::unordered_map<std::string_view, uint32_t> index_;   // 键指向 arena 中的字符
+  std::vector<std::string_view>                  names_{std::string_view()};
+  std::vector<std::unique_ptr<char[]>>           chunks_;
+  char*                                          cursor_     = nullptr;
+  size_t                                         remaining_  = 0;
+  size_t                                         arenaBytes_ = 0;
+
+  NameTable() = default;
+
+  // 顺序切分当前块；放不下时新开一块（超长的名字单独占一块）
+  auto store(std::string_view name) -> std::string_view {
+    if (name.size() > remaining_) {
+      const size_t bytes = name.size() > kChunkBytes ? name.size() : kChunkBytes;
+      chunks_.push_back(std::make_unique<char[]>(bytes));
+      cursor_    = chunks_.back().get();
+      remaining_ = bytes;
+      arenaBytes_ += bytes;
+    }
+    char* p = cursor_;
+    std::memcpy(p, name.data(), name.size());
+    cursor_ += name.size();
+    remaining_ -= name.size();
+    return {p, name.size()};
+  }
+};
+
+inline auto Symbol::view() const -> std::string_view { return NameTable::instance().lookup(*this); }
+
+inline auto intern(std::string_view name) -> Symbol { return NameTable::instance().intern(name); }
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef __PAGE_CACHE__H
+#define __PAGE_CACHE__H
+
+/**
+ * @file page_cache.h
+ * @brief 按字节预算淘汰的 LRU 页面缓存
+ *
+ * tutorial_23 的 WebBrowser 只用一个整数记录"缓存大小"，没有真正的缓存。PageCache 以 URL 为键
+ * 保存页面内容：
+ * - 预算按字节计算：每个页面的占用 = URL + 内容 + 节点和哈希表元素的固定开销，
+ *   插入后超出预算时从最久未使用的一端淘汰，直到回到预算以内；单个页面超过预算时不缓存
+ * - 页面节点自带 prev / next 指针，挂在带哨兵的侵入式双向链表上，哈希表的值就是节点本身：
+ *   查找、移到头部、淘汰都是 O(1)，除了新页面本身之外不分配内存（std::list + 哈希表的写法
+ *   要为链表节点和哈希表元素各分配一次，URL 也要存两份）
+ * - 哈希表的键是指向节点中 URL 的 string_view，查找时不需要构造 std::string
+ * - stats() 统计命中、未命中、插入、淘汰和因为过大而拒绝的次数
+ *
+ * clear() 直接换上一个新的空哈希表：释放旧表的桶数组而不是逐个清零，每个页面各释放一次，
+ * 这一代价摊到插入它的那次 put() 上，所以 clear() 的摊还代价是 O(1)，而且与哈希表曾经达到的
+ * 最大容量无关。
+ *
+ * 不是线程安全的。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+struct CacheStats {
+  uint64_t hits       = 0;
+  uint64_t misses     = 0;
+  uint64_t insertions = 0;   // put() 新增或替换的页面
+  uint64_t evictions  = 0;   // 为了回到预算以内而淘汰的页面
+  uint64_t rejections = 0;   // 超过预算、没有缓存的页面
+
+  [[nodiscard]] auto lookups() const -> uint64_t { return hits + misses; }
+
+  [[nodiscard]] auto hitRate() const -> double {
+    return lookups() == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups());
+  }
+
+  auto operator+=(const CacheStats& other) -> CacheStats& {
+    hits += other.hits;
+    misses += other.misses;
+    insertions += other.insertions;
+    evictions += other.evictions;
+    rejections += other.rejections;
+    return *this;
+  }
+};
+
+namespace page_cache_detail {
+
+struct Link {
+  Link* prev = nullptr;
+  Link* next = nullptr;
+};
+
+struct Page : Link {
+  std::string url;
+  std::string body;
+  size_t      charge  = 0;   // 计入预算的字节数
+  uint8_t     segment = 0;   // 所在的链表（TinyLfuPageCache 分为窗口、试用区和保护区）
+};
+
+// 每个页面除了 URL 和内容之外的开销：节点本身、哈希表元素（键、值、next 指针、哈希值）
+constexpr size_t kEntryOverhead = sizeof(Page) + sizeof(std::string_view) + 3 * sizeof(void*);
+
+inline auto chargeOf(std::string_view url, std::string_view body) -> size_t {
+  return url.size() + body.size() + kEntryOverhead;
+}
+
+// 带哨兵的侵入式双向链表：头部最近使用，尾部最久未使用。只链接节点，不拥有节点
+class LruList {
+  public:
+  LruList() { head_.prev = head_.next = &head_; }
+  LruList(const LruList&)                    = delete;
+  auto operator=(const LruList&) -> LruList& = delete;
+
+  [[nodiscard]] auto empty() const -> bool { return head_.next == &head_; }
+  [[nodiscard]] auto size() const -> size_t { return size_; }
+  [[nodiscard]] auto bytes() const -> size_t { return bytes_; }
+
+  // 最久未使用的页面；链表为空时返回 nullptr
+  [[nodiscard]] auto back() const -> Page* {
+    return empty() ? nullptr : static_cast<Page*>(head_.prev);
+  }
+
+  void pushFront(Page* page) {
+    page->prev       = &head_;
+    page->next       = head_.next;
+    head_.next->prev = page;
+    head_.next       = page;
+    ++size_;
+    bytes_ += page->charge;
+  }
+
+  void remove(Page* page) {
+    page->prev->next = page->next;
+    page->next->prev = page->prev;
+    page->prev = page->next = nullptr;
+    --size_;
+    bytes_ -= page->charge;
+  }
+
+  void moveToFront(Page* page) {
+    if (head_.next == page) {
+      return;
+    }
+    page->prev->next = page->next;
+    page->next->prev = page->prev;
+    page->prev       = &head_;
+    page->next       = head_.next;
+    head_.next->prev = page;
+    head_.next       = page;
+  }
+
+  // 忘掉所有节点（节点由调用方释放）
+  void reset() {
+    head_.prev = head_.next = &head_;
+    size_                   = 0;
+    bytes_                  = 0;
+  }
+
+  private:
+  Link   head_;
+  size_t size_  = 0;
+  size_t bytes_ = 0;
+};
+
+// 键指向节点中的 URL；节点在堆上，哈希表扩容时地址不变
+using PageIndex = std::unordered_map<std::string_view, std::unique_ptr<Page>>;
+
+}   // namespace page_cache_detail
+
+class PageCache {
+  public:
+  explicit PageCache(size_t byteBudget)
+    : budget_(byteBudget) {}
+
+  PageCache(const PageCache&)                    = delete;
+  auto operator=(const PageCache&) -> PageCache& = delete;
+
+  /**
+   * @brief 查找页面，命中时把它移到最近使用的一端
+   *
+   * 返回的指针在下一次 put() / erase() / clear() 之前有效；未命中时返回 nullptr。
+   */
+  auto get(std::string_view url) -> const std::string* {
+    const auto it = index_.find(url);
+    if (it == index_.end()) {
+      ++stats_.misses;
+      return nullptr;
+    }
+    ++stats_.hits;
+    lru_.moveToFront(it->second.get());
+    return &it->second->body;
+  }
+
+  // 不改变最近使用顺序，也不计入统计
+  [[nodiscard]] auto contains(std::string_view url) const -> bool {
+    return index_.find(url) != index_.end();
+  }
+
+  /**
+   * @brief 插入或替换页面，然后从最久未使用的一端淘汰，直到回到预算以内
+   *
+   * 页面本身超过预算时不缓存（同一 URL 的旧内容也会删除），返回 false。
+   */
+  auto put(std::string url, std::string body) -> bool {
+    const size_t charge = page_cache_detail::chargeOf(url, body);
+    const auto   it     = index_.find(url);
+    if (charge > budget_) {
+      if (it != index_.end()) {
+        unlinkAndErase(it);
+      }
+      ++stats_.rejections;
+      return false;
+    }
+    ++stats_.insertions;
+    if (it != index_.end()) {
+      // 替换内容：节点和哈希表元素都不变
+      page_cache_detail::Page* page = it->second.get();
+      lru_.remove(page);
+      page->body   = std::move(body);
+      page->charge = charge;
+      lru_.pushFront(page);
+    } else {
+      auto page    = std::make_unique<page_cache_detail::Page>();
+      page->url    = std::move(url);
+      page->body   = std::move(body);
+      page->charge = charge;
+      lru_.pushFront(page.get());
+      const std::string_view key = page->url;
+      index_.emplace(key, std::move(page));
+    }
+    evictOverBudget();
+    return true;
+  }
+
+  auto erase(std::string_view url) -> bool {
+    const auto it = index_.find(url);
+    if (it == index_.end()) {
+      return false;
+    }
+    unlinkAndErase(it);
+    return true;
+  }
+
+  // 统计保留
+  void clear() noexcept {
+    lru_.reset();
+    page_cache_detail::PageIndex().swap(index_);
+  }
+
+  // 与 clear() 相同，但把页面交给调用方，由它决定在哪里释放（例如在锁外）
+  [[nodiscard]] auto takePages() noexcept -> page_cache_detail::PageIndex {
+    lru_.reset();
+    page_cache_detail::PageIndex pages;
+    pages.swap(index_);
+    return pages;
+  }
+
+  // 缩小预算时立即淘汰
+  void setBudget(size_t byteBudget) {
+    budget_ = byteBudget;
+    evictOverBudget();
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return lru_.size(); }
+  [[nodiscard]] auto bytes() const -> size_t { return lru_.bytes(); }
+  [[nodiscard]] auto budget() const -> size_t { return budget_; }
+  [[nodiscard]] auto stats() const -> const CacheStats& { return stats_; }
+  void resetStats() { stats_ = {}; }
+
+  private:
+  size_t                       budget_;
+  page_cache_detail::LruList   lru_;
+  page_cache_detail::PageIndex index_;
+  CacheStats                   stats_;
+
+  void unlinkAndErase(page_cache_detail::PageIndex::iterator it) {
+    lru_.remove(it->second.get());
+    index_.erase(it);
+  }
+
+  void evictOverBudget() {
+    while (lru_.bytes() > budget_) {
+      unlinkAndErase(index_.find(lru_.back()->url));
+      ++stats_.evictions;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef __POLY_COLLECTION__H
+#define __POLY_COLLECTION__H
+
+/**
+ * @file poly_collection.h
+ * @brief 按具体类型分段连续存放的多态容器
+ *
+ * std::vector<std::unique_ptr<Base>> 中每个对象都单独分配在堆上，遍历时每个元素
+ * 一次间接寻址、一次虚函数调用，而且相邻元素的类型是随机的，间接跳转很难预测。
+ * PolyCollection<Base> 为每个具体类型 T 保存一个 std::vector<T>（一个“段”）：
+ * - emplace<T>(args...) 在 T 的段末尾就地构造对象，同类对象在内存中紧挨着
+ * - forEach(f) 逐段遍历，同一段内虚函数的目标都相同，分支预测器总能猜对
+ * - forEach<T1, T2, ...>(f) 对列出的类型按静态类型 T& 调用 f，T 声明为 final 时
+ *   虚函数调用被编译器去虚化并可以内联；没有列出的类型仍按 Base& 遍历
+ *
+ * 代价：遍历顺序是“按段、段内按插入顺序”，不是整体的插入顺序；
+ * 与 std::vector 一样，emplace 可能使同一段中已有元素的引用失效。
+ */
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+template<typename Base> class PolyCollection {
+  public:
+  // 在 T 的段中构造一个对象；返回的引用在下一次向同一段 emplace 之前有效
+  template<typename T, typename... Args> auto emplace(Args&&... args) -> T& {
+    static_assert(std::is_base_of_v<Base, T>, "T must derive from Base");
+    Segment<T>& segment = segmentFor<T>();
+    T&          item    = segment.items.emplace_back(std::forward<Args>(args)...);
+    segment.refresh();
+    ++size_;
+    return item;
+  }
+
+  // 为 T 的段预留空间，批量插入前调用可以避免反复扩容搬移
+  template<typename T> void reserve(size_t count) {
+    Segment<T>& segment = segmentFor<T>();
+    segment.items.reserve(count);
+    segment.refresh();
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return size_; }
+  [[nodiscard]] auto empty() const -> bool { return size_ == 0; }
+  [[nodiscard]] auto segmentCount() const -> size_t { return segments_.size(); }
+
+  template<typename T> [[nodiscard]] auto count() const -> size_t {
+    const SegmentBase* segment = find(typeid(T));
+    return segment == nullptr ? 0 : segment->size;
+  }
+
+  void clear() {
+    segments_.clear();
+    size_ = 0;
+  }
+
+  /**
+   * 逐段对每个元素调用 f
+   * Restituted 中列出的类型按 T& 传给 f（静态类型已知，可以去虚化），其余类型按 Base& 传给 f
+   */
+  template<typename... Restituted, typename F> void forEach(F&& f) {
+    for (const auto& segment : segments_) {
+      if (!(visitAs<Restituted>(*segment, f) || ...)) {
+        visitAsBase<Base>(*segment, f);
+      }
+    }
+  }
+
+  template<typename... Restituted, typename F> void forEach(F&& f) const {
+    for (const auto& segment : segments_) {
+      if (!(visitAs<Restituted>(std::as_const(*segment), f) || ...)) {
+        visitAsBase<const Base>(*segment, f);
+      }
+    }
+  }
+
+  private:
+  // 段的类型擦除接口：只记录元素个数和第一个元素中 Base 子对象的地址，
+  // 按 Base& 遍历时用步长 sizeof(T) 前进，不需要每个元素一次虚函数调用
+  struct SegmentBase {
+    explicit SegmentBase(const std::type_info& type, size_t stride)
+      : type(type)
+      , stride(stride) {}
+    virtual ~SegmentBase() = default;
+
+    std::type_index type;
+    size_t          stride;
+    Base*           first = nullptr;
+    size_t          size  = 0;
+  };
+
+  template<typename T> struct Segment final : SegmentBase {
+    Segment()
+      : SegmentBase(typeid(T), sizeof(T)) {}
+
+    // items 扩容后数据地址会变化
+    void refresh() {
+      this->first = items.empty() ? nullptr : static_cast<Base*>(items.data());
+      this->size  = items.size();
+    }
+
+    std::vector<T> items;
+  };
+
+  std::vector<std::unique_ptr<SegmentBase>> segments_;   // 段数等于具体类型数，通常很少
+  size_t                                    size_ = 0;
+
+  [[nodiscard]] auto find(const std::type_info& type) const -> SegmentBase* {
+    for (const auto& segment : segments_) {
+      if (segment->type == type) {
+        return segment.get();
+      }
+    }
+    return nullptr;
+  }
+
+  template<typename T> auto segmentFor() -> Segment<T>& {
+    if (SegmentBase* segment = find(typeid(T)); segment != nullptr) {
+      return static_cast<Segment<T>&>(*segment);
+    }
+    auto  created = std::make_unique<Segment<T>>();
+    auto& result  = *created;
+    segments_.push_back(std::move(created));
+    return result;
+  }
+
+  template<typename T, typename F> static auto visitAs(SegmentBase& segment, F& f) -> bool {
+    if (segment.type != typeid(T)) {
+      return false;
+    }
+    for (T& item : static_cast<Segment<T>&>(segment).items) {
+      f(item);
+    }
+    return true;
+  }
+
+  template<typename T, typename F> static auto visitAs(const SegmentBase& segment, F& f) -> bool {
+    if (segment.type != typeid(T)) {
+      return false;
+    }
+    for (const T& item : static_cast<const Segment<T>&>(segment).items) {
+      f(item);
+    }
+    return true;
+  }
+
+  // B 是 Base 或 const Base
+  template<typename B, typename F> static void visitAsBase(const SegmentBase& segment, F& f) {
+    auto* bytes = reinterpret_cast<unsigned char*>(segment.first);
+    for (size_t i = 0; i < segment.size; ++i, bytes += segment.stride) {
+      f(*reinterpret_cast<B*>(bytes));
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,292 @@
+#ifndef __RATIONAL__H
+#define __RATIONAL__H
+
+/**
+ * @file rational.h
+ * @brief 始终约分、检查溢出的 64 位有理数
+ *
+ * tutorial_21 的 Rational 和 tutorial_24 的 RationalNonMember 相乘时直接把分子、分母相乘，
+ * 从不约分：几次运算后 int 就会溢出，而且 1/2 和 2/4 是两个不同的表示。Rational64：
+ * - 不变式：分母为正，gcd(|分子|, 分母) == 1，所以值相等当且仅当表示相同
+ * - 约分用二进制 GCD（只有移位和减法，没有除法）
+ * - 乘法先交叉约分（a/b * c/d 先约掉 gcd(a, d) 和 gcd(c, b)），结果直接是最简形式；
+ *   加法按 Knuth 的方法只对分母的 gcd 做运算，中间结果用 128 位整数，不会提前溢出
+ * - 结果超出 int64_t 时抛出 std::overflow_error，而不是悄悄回绕；tryMul / tryAdd / trySub 不抛异常，
+ *   溢出时返回 false（big_rational.h 据此转为任意精度表示）
+ * - 快速路径：两个整数（分母为 1）相乘、相加不求 gcd；分母互素或相同的加法只求一次 gcd
+ *
+ * 与条款 24 一致，+ - * / 和比较都是非成员函数，通过公有的 += 等成员实现，不需要友元。
+ *
+ * 构造、约分和运算都是 constexpr：用 rational_literals 的 _r 字面量（3_r / 4）定义的 constexpr 常量、
+ * 换算表在编译期算出最简形式，直接放进 .rodata，不需要在启动时构造。常量求值中遇到 throw 会导致
+ * 编译失败，所以常量的分母为 0、除以 0 或溢出都是编译错误；运行时的值仍然抛出异常。
+ */
+
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+
+namespace rational_detail {
+
+// 二进制 GCD（Stein 算法）：去掉公共的 2 因子后，两个奇数反复"大减小、去掉末尾的 0"。
+// 每一步只有减法、ctz 和移位；min 和 |差| 编译成条件传送，循环里没有难以预测的分支
+constexpr auto binaryGcd(uint64_t a, uint64_t b) -> uint64_t {
+  if (a == 0 || b == 0) {
+    return a | b;
+  }
+  const int shift = __builtin_ctzll(a | b);
+  a >>= __builtin_ctzll(a);
+  b >>= __builtin_ctzll(b);
+  while (a != b) {
+    // b - a 与 |b - a| 末尾的 0 个数相同
+    const int      zeros = __builtin_ctzll(b - a);
+    const uint64_t lower = a < b ? a : b;
+    b                    = (a < b ? b - a : a - b) >> zeros;
+    a                    = lower;
+  }
+  return a << shift;
+}
+
+constexpr auto magnitude(int64_t x) -> uint64_t {
+  return x < 0 ? 0 - static_cast<uint64_t>(x) : static_cast<uint64_t>(x);
+}
+
+[[noreturn]] inline void overflow(const char* what) { throw std::overflow_error(what); }
+
+// 128 位结果收窄到 int64_t，超出范围时抛出异常
+constexpr auto narrow(__int128 value, const char* what) -> int64_t {
+  if (value > INT64_MAX || value < INT64_MIN) {
+    overflow(what);
+  }
+  return static_cast<int64_t>(value);
+}
+
+}   // namespace rational_detail
+
+class Rational64 {
+  public:
+  // 不声明为 explicit：与条款 24 一样，整数可以隐式转换成有理数
+  constexpr Rational64(int64_t numerator = 0, int64_t denominator = 1) {
+    if (denominator == 0) {
+      throw std::invalid_argument("Denominator cannot be zero");
+    }
+    if (denominator == 1) {
+      num_ = numerator;
+      return;
+    }
+    const uint64_t g = rational_detail::binaryGcd(
+      rational_detail::magnitude(numerator), rational_detail::magnitude(denominator));
+    __int128 n = numerator / static_cast<int64_t>(g);
+    __int128 d = denominator / static_cast<int64_t>(g);
+    if (d < 0) {
+      n = -n;
+      d = -d;
+    }
+    num_ = rational_detail::narrow(n, "Rational64: numerator overflow");
+    den_ = rational_detail::narrow(d, "Rational64: denominator overflow");
+  }
+
+  [[nodiscard]] constexpr auto numerator() const -> int64_t { return num_; }
+  [[nodiscard]] constexpr auto denominator() const -> int64_t { return den_; }
+  [[nodiscard]] constexpr auto isInteger() const -> bool { return den_ == 1; }
+  [[nodiscard]] constexpr auto toDouble() const -> double {
+    return static_cast<double>(num_) / static_cast<double>(den_);
+  }
+
+  constexpr auto operator-() const -> Rational64 {
+    if (num_ == INT64_MIN) {
+      rational_detail::overflow("Rational64: negation overflow");
+    }
+    return reduced(-num_, den_);
+  }
+
+  // 不抛异常的版本：结果超出 int64_t 时返回 false，out 不变
+  [[nodiscard]] static constexpr auto tryMul(Rational64 a, Rational64 b, Rational64& out) noexcept
+    -> bool {
+    if (a.den_ == 1 && b.den_ == 1) {
+      int64_t product = 0;
+      if (__builtin_mul_overflow(a.num_, b.num_, &product)) {
+        return false;
+      }
+      out = reduced(product, 1);
+      return true;
+    }
+    // 交叉约分：(a/b) * (c/d) = (a/g1 * c/g2) / (b/g2 * d/g1)，g1 = gcd(a, d)，g2 = gcd(c, b)
+    // 约分后分子、分母互素，不需要再求 gcd
+    const auto g1 = static_cast<int64_t>(rational_detail::binaryGcd(
+      rational_detail::magnitude(a.num_), static_cast<uint64_t>(b.den_)));
+    const auto g2 = static_cast<int64_t>(rational_detail::binaryGcd(
+      rational_detail::magnitude(b.num_), static_cast<uint64_t>(a.den_)));
+    const __int128 n = static_cast<__int128>(a.num_ / g1) * (b.num_ / g2);
+    const __int128 d = static_cast<__int128>(a.den_ / g2) * (b.den_ / g1);
+    return store(n, d, out);
+  }
+
+  [[nodiscard]] static constexpr auto tryAdd(Rational64 a, Rational64 b, Rational64& out) noexcept
+    -> bool {
+    return add(a, b.num_, b.den_, out);
+  }
+
+  [[nodiscard]] static constexpr auto trySub(Rational64 a, Rational64 b, Rational64& out) noexcept
+    -> bool {
+    // -b.num_ 用 128 位计算，INT64_MIN 也不会溢出
+    return add(a, -static_cast<__int128>(b.num_), b.den_, out);
+  }
+
+  constexpr auto operator*=(const Rational64& rhs) -> Rational64& {
+    if (!tryMul(*this, rhs, *this)) {
+      rational_detail::overflow("Rational64: multiplication overflow");
+    }
+    return *this;
+  }
+
+  constexpr auto operator/=(const Rational64& rhs) -> Rational64& {
+    if (rhs.num_ == 0) {
+      throw std::domain_error("Rational64: division by zero");
+    }
+    if (num_ == 0) {
+      return *this;
+    }
+    // 直接交叉约分 (a/b) / (c/d) = (a/g1 * d/g2) / (b/g2 * c/g1)，g1 = gcd(a, c)，g2 = gcd(b, d)，
+    // 不经过 reciprocal()：c 为 INT64_MIN 时 |c| 放不进 int64_t，这里在 128 位中取绝对值并把符号
+    // 移到分子上
+    const uint64_t aAbs = rational_detail::magnitude(num_);
+    const uint64_t cAbs = rational_detail::magnitude(rhs.num_);
+    const uint64_t g1   = rational_detail::binaryGcd(aAbs, cAbs);
+    const auto     g2   = static_cast<int64_t>(rational_detail::binaryGcd(
+      static_cast<uint64_t>(den_), static_cast<uint64_t>(rhs.den_)));
+    __int128 n = static_cast<__int128>(aAbs / g1) * (rhs.den_ / g2);
+    if ((num_ < 0) != (rhs.num_ < 0)) {
+      n = -n;
+    }
+    const __int128 d = static_cast<__int128>(den_ / g2) * (cAbs / g1);
+    if (!store(n, d, *this)) {
+      rational_detail::overflow("Rational64: division overflow");
+    }
+    return *this;
+  }
+
+  constexpr auto operator+=(const Rational64& rhs) -> Rational64& {
+    if (!tryAdd(*this, rhs, *this)) {
+      rational_detail::overflow("Rational64: addition overflow");
+    }
+    return *this;
+  }
+
+  constexpr auto operator-=(const Rational64& rhs) -> Rational64& {
+    if (!trySub(*this, rhs, *this)) {
+      rational_detail::overflow("Rational64: subtraction overflow");
+    }
+    return *this;
+  }
+
+  [[nodiscard]] constexpr auto reciprocal() const -> Rational64 {
+    if (num_ == 0) {
+      throw std::domain_error("Rational64: reciprocal of zero");
+    }
+    if (num_ == INT64_MIN) {
+      rational_detail::overflow("Rational64: reciprocal overflow");
+    }
+    return num_ < 0 ? reduced(-den_, -num_) : reduced(den_, num_);
+  }
+
+  private:
+  int64_t num_ = 0;
+  int64_t den_ = 1;
+
+  // 已经是最简形式的分子、分母，跳过约分
+  static constexpr auto reduced(int64_t numerator, int64_t denominator) -> Rational64 {
+    Rational64 r;
+    r.num_ = numerator;
+    r.den_ = denominator;
+    return r;
+  }
+
+  // 已经约分的 128 位结果放回 int64_t；超出范围时返回 false
+  static constexpr auto store(__int128 n, __int128 d, Rational64& out) noexcept -> bool {
+    if (n > INT64_MAX || n < INT64_MIN || d > INT64_MAX) {
+      return false;
+    }
+    out = reduced(static_cast<int64_t>(n), static_cast<int64_t>(d));
+    return true;
+  }
+
+  // Knuth 4.5.1：a/b + c/d，g = gcd(b, d)
+  // g == 1 时 (ad + cb) / bd 已经是最简形式；否则 t = a(d/g) + c(b/g)，结果是 (t/g2) / ((b/g)(d/g2))，
+  // 其中 g2 = gcd(t, g)。t 最多 128 位，只需要对 t mod g 求 gcd
+  static constexpr auto add(Rational64 lhs, __int128 c, int64_t d, Rational64& out) noexcept
+    -> bool {
+    if (lhs.den_ == d) {
+      if (d == 1) {
+        return store(lhs.num_ + c, 1, out);
+      }
+      // 分母相同：t = a + c，g = d
+      return addReduced(lhs.num_ + c, 1, d, d, out);
+    }
+    const int64_t b = lhs.den_;
+    const auto    g = static_cast<int64_t>(
+      rational_detail::binaryGcd(static_cast<uint64_t>(b), static_cast<uint64_t>(d)));
+    const __int128 t = lhs.num_ * static_cast<__int128>(d / g) + c * (b / g);
+    return addReduced(t, b / g, d, g, out);
+  }
+
+  // 结果为 t / (left * right)，其中 g 是 right 与 left 合并前的公因子
+  static constexpr auto addReduced(
+    __int128 t, int64_t left, int64_t right, int64_t g, Rational64& out) noexcept -> bool {
+    if (t == 0) {
+      out = reduced(0, 1);
+      return true;
+    }
+    const auto tModG = static_cast<uint64_t>((t < 0 ? -t : t) % g);
+    const auto g2    = static_cast<int64_t>(rational_detail::binaryGcd(tModG, g));
+    return store(t / g2, static_cast<__int128>(left) * (right / g2), out);
+  }
+};
+
+// 非成员、非友元的运算符：两个操作数都可以隐式转换
+constexpr auto operator*(Rational64 lhs, const Rational64& rhs) -> Rational64 { return lhs *= rhs; }
+constexpr auto operator/(Rational64 lhs, const Rational64& rhs) -> Rational64 { return lhs /= rhs; }
+constexpr auto operator+(Rational64 lhs, const Rational64& rhs) -> Rational64 { return lhs += rhs; }
+constexpr auto operator-(Rational64 lhs, const Rational64& rhs) -> Rational64 { return lhs -= rhs; }
+
+// 最简形式唯一，相等比较只需比较分子和分母
+constexpr auto operator==(const Rational64& lhs, const Rational64& rhs) -> bool {
+  return lhs.numerator() == rhs.numerator() && lhs.denominator() == rhs.denominator();
+}
+constexpr auto operator!=(const Rational64& lhs, const Rational64& rhs) -> bool {
+  return !(lhs == rhs);
+}
+// 交叉相乘用 128 位，不会溢出
+constexpr auto operator<(const Rational64& lhs, const Rational64& rhs) -> bool {
+  return static_cast<__int128>(lhs.numerator()) * rhs.denominator() <
+         static_cast<__int128>(rhs.numerator()) * lhs.denominator();
+}
+constexpr auto operator>(const Rational64& lhs, const Rational64& rhs) -> bool { return rhs < lhs; }
+constexpr auto operator<=(const Rational64& lhs, const Rational64& rhs) -> bool {
+  return !(rhs < lhs);
+}
+constexpr auto operator>=(const Rational64& lhs, const Rational64& rhs) -> bool {
+  return !(lhs < rhs);
+}
+
+inline auto operator<<(std::ostream& os, const Rational64& r) -> std::ostream& {
+  os << r.numerator();
+  if (!r.isInteger()) {
+    os << '/' << r.denominator();
+  }
+  return os;
+}
+
+namespace rational_literals {
+
+// 整数字面量：constexpr Rational64 kInch = 254_r / 10000; 在编译期约分为 127/5000
+constexpr auto operator""_r(unsigned long long value) -> Rational64 {
+  if (value > INT64_MAX) {
+    rational_detail::overflow("Rational64: literal overflow");
+  }
+  return Rational64(static_cast<int64_t>(value));
+}
+
+}   // namespace rational_literals
+
+#endif
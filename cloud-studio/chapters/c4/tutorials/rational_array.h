@@ -0,0 +1,284 @@
+#ifndef __RATIONAL_ARRAY__H
+#define __RATIONAL_ARRAY__H
+
+/**
+ * @file rational_array.h
+ * @brief 列式存储的有理数数组与批量运算
+ *
+ * std::vector<RationalNonMember> 把每个值的分子、分母放在一起，逐个调用 operator*，
+ * 每次运算都有依赖数据的分支（gcd 的循环），编译器无法向量化。RationalArray 把分子、分母分别
+ * 存放在两个 int32_t 数组中（与 RationalNonMember 的 int 相同），每个值都是最简形式、分母为正，
+ * 批量运算分三步，每一步都是没有分支的循环，编译器可以生成 SIMD 指令：
+ * - 用 64 位整数算出精确的、未约分的结果：a/b * c/d = ac / bd，a/b + c/d = (ad + cb) / bd
+ * - rational_batch::normalize() 成批约分：每组 kGcdLanes 个值同步执行二进制 GCD，
+ *   末尾 0 的个数用整数转浮点数后的指数求出，取最小值、相减都编译成 SIMD 的条件选择；
+ *   gcd = 奇数部分 << shift，除以 gcd 等于右移 shift 位再乘以奇数部分模 2^64 的逆元，不需要除法
+ * - 收窄回 int32_t，用一个标志记录是否有值超出范围；溢出时抛出 std::overflow_error，输出不变
+ * dot() 先批量相乘，再把乘积两两相加（每一层都是一次批量加法）；乘积或某一层溢出 int32_t 时，
+ * 剩下的部分改用 Rational64 逐个累加。
+ *
+ * 同步执行的 GCD 需要 AVX-512 的 64 位最小值、乘法和整数到浮点数的转换（用 -march=native 编译）；
+ * 其他平台上（RATIONAL_BATCH_SIMD 未定义）每个值单独计算二进制 GCD，其余步骤不变。
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "rational.h"
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+#  define RATIONAL_BATCH_SIMD 1
+#endif
+
+namespace rational_batch {
+
+constexpr size_t kGcdLanes = 64;     // 同步执行 GCD 的值的个数
+constexpr size_t kBlock    = 1024;   // 批量运算的分块大小，中间结果留在 L1 缓存中
+
+// x 末尾 0 的个数（x != 0）。x & -x 只有一位是 1，转成 double 是精确的，指数就是这一位的位置
+inline auto trailingZeros(uint64_t x) -> uint64_t {
+  const auto lowest = static_cast<double>(static_cast<int64_t>(x & (0 - x)));
+  uint64_t   bits   = 0;
+  std::memcpy(&bits, &lowest, sizeof(bits));
+  return ((bits >> 52) & 0x7ff) - 1023;
+}
+
+// 奇数 x 模 2^64 的逆元：x * x ≡ 1 (mod 8)，牛顿迭代每次把正确的位数翻倍
+inline auto inverse(uint64_t x) -> uint64_t {
+  uint64_t inv = x;
+  for (int i = 0; i < 5; ++i) {
+    inv *= 2 - x * inv;
+  }
+  return inv;
+}
+
+// 约分恰好 kGcdLanes 个值；循环次数是常量，编译器不需要处理剩余部分
+inline void normalizeLanes(int64_t* n, int64_t* d) {
+  uint64_t u[kGcdLanes];       // gcd 的奇数部分
+  uint64_t shift[kGcdLanes];   // gcd 末尾 0 的个数
+
+#if defined(RATIONAL_BATCH_SIMD)
+  constexpr uint64_t kTopBit = uint64_t{1} << 63;   // 与 0 合并后末尾 0 的个数是 63，右移后仍为 0
+  uint64_t           v[kGcdLanes];
+
+  // gcd(|n|, d)：去掉公共的 2 因子，u 变成奇数；n == 0 时 gcd 就是 d
+  for (size_t i = 0; i < kGcdLanes; ++i) {
+    const uint64_t a = static_cast<uint64_t>(n[i] < 0 ? -n[i] : n[i]);
+    const uint64_t b = static_cast<uint64_t>(d[i]);
+    const uint64_t x = a == 0 ? b : a;
+    shift[i]         = trailingZeros(x | b);
+    u[i]             = x >> trailingZeros(x);
+    v[i]             = a == 0 ? 0 : b;
+  }
+
+  // 所有通道同步迭代：v 去掉末尾的 0，然后 (u, v) = (min, max - min)，直到所有 v 都为 0。
+  // 已经结束的通道（v == 0）让 w = u，min、max 都是 u，差仍为 0
+  for (uint64_t active = 1; active != 0;) {
+    active = 0;
+    for (size_t i = 0; i < kGcdLanes; ++i) {
+      const uint64_t odd = v[i] >> trailingZeros(v[i] | kTopBit);
+      const uint64_t w   = odd == 0 ? u[i] : odd;
+      const uint64_t low = std::min(u[i], w);
+      v[i]               = std::max(u[i], w) - low;
+      u[i]               = low;
+      active |= v[i];
+    }
+  }
+#else
+  // 没有 64 位向量乘法和整数到浮点数的转换时，同步迭代比逐个计算更慢
+  for (size_t i = 0; i < kGcdLanes; ++i) {
+    const uint64_t g = rational_detail::binaryGcd(
+      rational_detail::magnitude(n[i]), static_cast<uint64_t>(d[i]));
+    shift[i] = static_cast<uint64_t>(__builtin_ctzll(g));
+    u[i]     = g >> shift[i];
+  }
+#endif
+
+  // 除以 gcd = u << shift：先右移，再乘以 u 的逆元（整除时结果精确）
+  for (size_t i = 0; i < kGcdLanes; ++i) {
+    const uint64_t inv = inverse(u[i]);
+    n[i]               = static_cast<int64_t>(static_cast<uint64_t>(n[i] >> shift[i]) * inv);
+    d[i]               = static_cast<int64_t>(static_cast<uint64_t>(d[i] >> shift[i]) * inv);
+  }
+}
+
+/**
+ * @brief 把 num[i] / den[i] 约分成最简形式，要求 den[i] > 0
+ *
+ * |num[i]| 和 den[i] 都必须小于 2^63。
+ */
+inline void normalize(int64_t* num, int64_t* den, size_t count) {
+  size_t base = 0;
+  for (; base + kGcdLanes <= count; base += kGcdLanes) {
+    normalizeLanes(num + base, den + base);
+  }
+  if (base == count) {
+    return;
+  }
+  // 剩余不足一组：补上 0/1 凑成一组
+  int64_t n[kGcdLanes] = {};
+  int64_t d[kGcdLanes];
+  std::fill(std::begin(d), std::end(d), 1);
+  std::copy(num + base, num + count, n);
+  std::copy(den + base, den + count, d);
+  normalizeLanes(n, d);
+  std::copy(n, n + (count - base), num + base);
+  std::copy(d, d + (count - base), den + base);
+}
+
+}   // namespace rational_batch
+
+class RationalArray {
+  public:
+  RationalArray() = default;
+
+  // count 个 0
+  explicit RationalArray(size_t count)
+    : num_(count, 0)
+    , den_(count, 1) {}
+
+  // 逐个约分，分母为 0 时抛出 std::invalid_argument
+  void push_back(int32_t numerator, int32_t denominator = 1) {
+    const Rational64 value(numerator, denominator);
+    // 分母为 INT32_MIN 时符号移到分子上，分母变成 2^31
+    if (value.numerator() < INT32_MIN || value.numerator() > INT32_MAX ||
+        value.denominator() > INT32_MAX) {
+      throw std::overflow_error("RationalArray: value does not fit in int32_t");
+    }
+    num_.push_back(static_cast<int32_t>(value.numerator()));
+    den_.push_back(static_cast<int32_t>(value.denominator()));
+  }
+
+  void reserve(size_t count) {
+    num_.reserve(count);
+    den_.reserve(count);
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return num_.size(); }
+  [[nodiscard]] auto numerator(size_t i) const -> int32_t { return num_[i]; }
+  [[nodiscard]] auto denominator(size_t i) const -> int32_t { return den_[i]; }
+  [[nodiscard]] auto at(size_t i) const -> Rational64 { return Rational64(num_[i], den_[i]); }
+
+  /**
+   * @brief out[i] = a[i] * b[i]
+   *
+   * a、b 长度必须相同；out 可以是 a 或 b。结果超出 int32_t 时抛出 std::overflow_error，out 不变。
+   */
+  static void multiply(const RationalArray& a, const RationalArray& b, RationalArray& out) {
+    apply<Multiply>(a, b, out);
+  }
+
+  // out[i] = a[i] + b[i]，约定同 multiply()
+  static void add(const RationalArray& a, const RationalArray& b, RationalArray& out) {
+    apply<Add>(a, b, out);
+  }
+
+  // sum(a[i] * b[i])；结果超出 Rational64 时抛出 std::overflow_error
+  [[nodiscard]] static auto dot(const RationalArray& a, const RationalArray& b) -> Rational64 {
+    if (a.size() != b.size()) {
+      throw std::invalid_argument("RationalArray: size mismatch");
+    }
+    RationalArray level(a.size());
+    if (!combine<Multiply>(a, 0, b, 0, a.size(), level)) {
+      // 有乘积超出 int32_t：全部改用 Rational64 逐个相乘、累加
+      Rational64 sum;
+      for (size_t i = 0; i < a.size(); ++i) {
+        sum += a.at(i) * b.at(i);
+      }
+      return sum;
+    }
+    // 两两相加：level[i] = level[i] + level[i + half]，奇数个时最后一个留到下一层
+    while (level.size() > 1) {
+      const size_t  half = level.size() / 2;
+      RationalArray next;
+      next.num_.resize(level.size() - half);
+      next.den_.resize(level.size() - half);
+      if (!combine<Add>(level, 0, level, half, half, next)) {
+        break;
+      }
+      if (level.size() % 2 != 0) {
+        next.num_[half] = level.num_.back();
+        next.den_[half] = level.den_.back();
+      }
+      level = std::move(next);
+    }
+    Rational64 sum;
+    for (size_t i = 0; i < level.size(); ++i) {
+      sum += level.at(i);
+    }
+    return sum;
+  }
+
+  private:
+  std::vector<int32_t> num_;
+  std::vector<int32_t> den_;
+
+  struct Multiply {
+    static void wide(int32_t a, int32_t b, int32_t c, int32_t d, int64_t& num, int64_t& den) {
+      num = static_cast<int64_t>(a) * c;
+      den = static_cast<int64_t>(b) * d;
+    }
+  };
+
+  // |ad + cb| <= 2^31 * (2^31 - 1) * 2 < 2^63，不会溢出
+  struct Add {
+    static void wide(int32_t a, int32_t b, int32_t c, int32_t d, int64_t& num, int64_t& den) {
+      num = static_cast<int64_t>(a) * d + static_cast<int64_t>(c) * b;
+      den = static_cast<int64_t>(b) * d;
+    }
+  };
+
+  template<typename Op>
+  static void apply(const RationalArray& a, const RationalArray& b, RationalArray& out) {
+    if (a.size() != b.size()) {
+      throw std::invalid_argument("RationalArray: size mismatch");
+    }
+    RationalArray result;
+    result.num_.resize(a.size());
+    result.den_.resize(a.size());
+    if (!combine<Op>(a, 0, b, 0, a.size(), result)) {
+      throw std::overflow_error("RationalArray: result does not fit in int32_t");
+    }
+    out = std::move(result);
+  }
+
+  // out[i] = Op(a[aFrom + i], b[bFrom + i])，i < count；有结果超出 int32_t 时返回 false
+  template<typename Op>
+  static auto combine(const RationalArray& a,
+                      size_t               aFrom,
+                      const RationalArray& b,
+                      size_t               bFrom,
+                      size_t               count,
+                      RationalArray&       out) -> bool {
+    int64_t  num[rational_batch::kBlock];
+    int64_t  den[rational_batch::kBlock];
+    uint64_t overflow = 0;
+    for (size_t base = 0; base < count; base += rational_batch::kBlock) {
+      const size_t   len = std::min(rational_batch::kBlock, count - base);
+      const int32_t* an  = a.num_.data() + aFrom + base;
+      const int32_t* ad  = a.den_.data() + aFrom + base;
+      const int32_t* bn  = b.num_.data() + bFrom + base;
+      const int32_t* bd  = b.den_.data() + bFrom + base;
+      for (size_t i = 0; i < len; ++i) {
+        Op::wide(an[i], ad[i], bn[i], bd[i], num[i], den[i]);
+      }
+      rational_batch::normalize(num, den, len);
+      int32_t* on = out.num_.data() + base;
+      int32_t* od = out.den_.data() + base;
+      for (size_t i = 0; i < len; ++i) {
+        overflow |= static_cast<uint64_t>(num[i] < INT32_MIN || num[i] > INT32_MAX ||
+                                          den[i] > INT32_MAX);
+        on[i] = static_cast<int32_t>(num[i]);
+        od[i] = static_cast<int32_t>(den[i]);
+      }
+    }
+    return overflow == 0;
+  }
+};
+
+#endif
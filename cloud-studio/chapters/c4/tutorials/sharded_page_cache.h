@@ -0,0 +1,154 @@
+#ifndef __SHARDED_PAGE_CACHE__H
+#define __SHARDED_PAGE_CACHE__H
+
+/**
+ * @file sharded_page_cache.h
+ * @brief 按 URL 哈希分片、每个分片一把锁的并发页面缓存
+ *
+ * PageCache 的 get() 也要修改链表（把页面移到头部），多个线程共用一个缓存时只能整体加锁，
+ * 所有线程都在同一把锁上排队。ShardedPageCache 把 URL 按哈希分到若干分片：
+ * - 每个分片有自己的 std::mutex 和自己的 PageCache（各自做 LRU 淘汰），预算平均分配；
+ *   访问不同分片的线程互不等待。分片按缓存行对齐，相邻分片的锁不会落在同一缓存行上
+ * - 分片号取哈希值乘以一个奇数后的高位，与分片内哈希表使用的低位无关
+ * - 返回指针在多线程下不安全（其他线程随时可能淘汰页面），所以读取通过 visit()
+ *   在分片锁内回调，或者用 get() 拷贝一份
+ * - clear() 逐个分片加锁，只在锁内取出页面，释放在锁外进行：任何时刻最多锁住一个分片，
+ *   而且只锁很短的时间，其他线程可以继续浏览。代价是清空不是原子的：clear() 返回前，
+ *   已经清空的分片可能又放进了新页面
+ * - stats()、size()、bytes() 逐个分片汇总，同样不是一致的快照
+ *
+ * 每个分片是独立的 LRU，全局的淘汰顺序只是近似 LRU；某个分片的热点页面超出它的那份预算时，
+ * 即使其他分片有空闲也会被淘汰。分片的预算（总预算 / 分片数）要远大于单个页面，否则页面会被拒绝。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "page_cache.h"
+
+class ShardedPageCache {
+  public:
+  static constexpr size_t kDefaultShards = 64;
+
+  // shardCount 向上取 2 的幂
+  explicit ShardedPageCache(size_t byteBudget, size_t shardCount = kDefaultShards)
+    : budget_(byteBudget) {
+    size_t shards = 1;
+    while (shards < shardCount) {
+      shards *= 2;
+      ++shardBits_;
+    }
+    shards_.reserve(shards);
+    for (size_t i = 0; i < shards; ++i) {
+      shards_.push_back(std::make_unique<Shard>(byteBudget / shards));
+    }
+  }
+
+  ShardedPageCache(const ShardedPageCache&)                    = delete;
+  auto operator=(const ShardedPageCache&) -> ShardedPageCache& = delete;
+
+  /**
+   * @brief 命中时在分片锁内调用 reader(const std::string& body)，返回是否命中
+   *
+   * reader 执行期间持有分片锁：不要在其中访问同一个缓存，也不要做耗时的操作。
+   */
+  template<typename F> auto visit(std::string_view url, F&& reader) -> bool {
+    Shard&                      shard = shardFor(url);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const std::string*          body = shard.cache.get(url);
+    if (body == nullptr) {
+      return false;
+    }
+    std::forward<F>(reader)(*body);
+    return true;
+  }
+
+  // 命中时返回页面内容的拷贝
+  auto get(std::string_view url) -> std::optional<std::string> {
+    std::optional<std::string> result;
+    visit(url, [&](const std::string& body) { result = body; });
+    return result;
+  }
+
+  // 约定同 PageCache::put()，预算是所在分片的那一份
+  auto put(std::string url, std::string body) -> bool {
+    Shard&                      shard = shardFor(url);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.cache.put(std::move(url), std::move(body));
+  }
+
+  auto erase(std::string_view url) -> bool {
+    Shard&                      shard = shardFor(url);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.cache.erase(url);
+  }
+
+  // 逐个分片清空，页面在锁外释放
+  void clear() {
+    for (const auto& shard : shards_) {
+      page_cache_detail::PageIndex pages;
+      {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        pages = shard->cache.takePages();
+      }
+    }
+  }
+
+  [[nodiscard]] auto stats() const -> CacheStats {
+    CacheStats total;
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      total += shard->cache.stats();
+    }
+    return total;
+  }
+
+  [[nodiscard]] auto size() const -> size_t {
+    return sum([](const PageCache& cache) { return cache.size(); });
+  }
+  [[nodiscard]] auto bytes() const -> size_t {
+    return sum([](const PageCache& cache) { return cache.bytes(); });
+  }
+  [[nodiscard]] auto budget() const -> size_t { return budget_; }
+  [[nodiscard]] auto shardCount() const -> size_t { return shards_.size(); }
+
+  private:
+  struct alignas(64) Shard {
+    explicit Shard(size_t byteBudget)
+      : cache(byteBudget) {}
+
+    mutable std::mutex mutex;
+    PageCache          cache;
+  };
+
+  size_t                              budget_;
+  unsigned                            shardBits_ = 0;
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  auto shardFor(std::string_view url) -> Shard& {
+    if (shardBits_ == 0) {
+      return *shards_[0];
+    }
+    const uint64_t hash = std::hash<std::string_view>{}(url) * 0x9e3779b97f4a7c15;
+    return *shards_[hash >> (64 - shardBits_)];
+  }
+
+  template<typename F> auto sum(F&& field) const -> size_t {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      total += field(shard->cache);
+    }
+    return total;
+  }
+};
+
+#endif
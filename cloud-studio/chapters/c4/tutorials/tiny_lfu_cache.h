@@ -0,0 +1,316 @@
+#ifndef __TINY_LFU_CACHE__H
+#define __TINY_LFU_CACHE__H
+
+/**
+ * @file tiny_lfu_cache.h
+ * @brief 带频率准入过滤的页面缓存（W-TinyLFU），抵抗一次性访问的扫描流量
+ *
+ * 普通 LRU 把每个新页面都放到最近使用的一端：爬虫式的流量里大量 URL 只访问一次，
+ * 它们会把真正的热门页面挤出缓存。TinyLfuPageCache 与 PageCache 接口相同、按字节计算预算，
+ * 但把预算分成三段：
+ * - 窗口（1%）：新页面先进入一个小的 LRU，吸收短时间内的突发访问
+ * - 试用区（主区的 20%）和保护区（主区的 80%）：分段 LRU。试用区中的页面再次命中时升入保护区，
+ *   保护区超出预算时最久未使用的页面降回试用区
+ * - 准入：窗口超出预算时，最久未使用的页面成为候选，与主区最久未使用的页面（先找试用区）比较
+ *   估计的访问频率；候选更频繁才淘汰对方进入试用区，否则候选本身被淘汰（计入 evictions）
+ *
+ * 访问频率由 FrequencySketch 估计：count-min sketch，每个 URL 对应 4 个 4 位计数器，取最小值；
+ * 表的大小是缓存页面数向上取 2 的幂个 64 位字，每个页面约 8～16 字节；记录的是包括已经被淘汰的
+ * URL 在内的所有访问。
+ * 计数达到采样数（表大小的 10 倍）后所有计数器减半，过去的热门页面会逐渐冷却。
+ *
+ * clear() 同时清空频率记录：它们也是浏览痕迹。不是线程安全的。
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "page_cache.h"
+
+/**
+ * @brief 4 位计数器的 count-min sketch
+ *
+ * 每个 64 位字有 16 个计数器，计数器饱和于 15。一个键在 4 个字中各选一个计数器，
+ * 估计值是其中的最小值（只会高估，不会低估）。
+ */
+class FrequencySketch {
+  public:
+  explicit FrequencySketch(size_t capacity = 0) { ensureCapacity(capacity); }
+
+  // 预计要区分的键超过当前容量时扩大表，计数清零
+  void ensureCapacity(size_t capacity) {
+    size_t words = kMinWords;
+    while (words < capacity) {
+      words *= 2;
+    }
+    if (words <= table_.size()) {
+      return;
+    }
+    table_.assign(words, 0);
+    sampleSize_ = 10 * words;
+    additions_  = 0;
+  }
+
+  void increment(uint64_t hash) {
+    bool added = false;
+    for (int i = 0; i < kDepth; ++i) {
+      const auto [word, shift] = slot(hash, i);
+      const uint64_t mask      = uint64_t{0xf} << shift;
+      if ((table_[word] & mask) != mask) {
+        table_[word] += uint64_t{1} << shift;
+        added = true;
+      }
+    }
+    if (added && ++additions_ >= sampleSize_) {
+      age();
+    }
+  }
+
+  [[nodiscard]] auto estimate(uint64_t hash) const -> uint32_t {
+    uint32_t frequency = 0xf;
+    for (int i = 0; i < kDepth; ++i) {
+      const auto [word, shift] = slot(hash, i);
+      frequency = std::min(frequency, static_cast<uint32_t>((table_[word] >> shift) & 0xf));
+    }
+    return frequency;
+  }
+
+  // 所有计数器减半
+  void age() {
+    for (auto& word : table_) {
+      word = (word >> 1) & 0x7777777777777777;
+    }
+    additions_ /= 2;
+  }
+
+  void clear() {
+    std::fill(table_.begin(), table_.end(), 0);
+    additions_ = 0;
+  }
+
+  [[nodiscard]] auto words() const -> size_t { return table_.size(); }
+
+  private:
+  static constexpr int      kDepth         = 4;
+  static constexpr size_t   kMinWords      = 64;
+  static constexpr uint64_t kSeeds[kDepth] = {
+    0xc3a5c85c97cb3127, 0xb492b66fbe98f273, 0x9ae16a3b2f90404f, 0xcbf29ce484222325};
+
+  std::vector<uint64_t> table_;
+  size_t                sampleSize_ = 0;
+  size_t                additions_  = 0;
+
+  // 第 i 个计数器：低位选字，最高 4 位选字中的计数器
+  [[nodiscard]] auto slot(uint64_t hash, int i) const -> std::pair<size_t, unsigned> {
+    uint64_t h = (hash + kSeeds[i]) * 0x9e3779b97f4a7c15;
+    h ^= h >> 29;
+    return {static_cast<size_t>(h & (table_.size() - 1)), static_cast<unsigned>(h >> 60) * 4};
+  }
+};
+
+class TinyLfuPageCache {
+  public:
+  explicit TinyLfuPageCache(size_t byteBudget) { setBudget(byteBudget); }
+
+  TinyLfuPageCache(const TinyLfuPageCache&)                    = delete;
+  auto operator=(const TinyLfuPageCache&) -> TinyLfuPageCache& = delete;
+
+  // 约定同 PageCache::get()；命中和未命中都计入访问频率
+  auto get(std::string_view url) -> const std::string* {
+    sketch_.increment(hashOf(url));
+    const auto it = index_.find(url);
+    if (it == index_.end()) {
+      ++stats_.misses;
+      return nullptr;
+    }
+    ++stats_.hits;
+    promote(it->second.get());
+    return &it->second->body;
+  }
+
+  [[nodiscard]] auto contains(std::string_view url) const -> bool {
+    return index_.find(url) != index_.end();
+  }
+
+  /**
+   * @brief 插入或替换页面：新页面先进入窗口，窗口溢出的页面经过准入比较才能进入主区
+   *
+   * 页面超过主区预算时不缓存（同一 URL 的旧内容也会删除），返回 false。
+   * 返回 true 只表示页面进入了窗口，之后仍可能在准入时被淘汰。
+   */
+  auto put(std::string url, std::string body) -> bool {
+    const size_t charge = page_cache_detail::chargeOf(url, body);
+    const auto   it     = index_.find(url);
+    if (charge > mainBudget_) {
+      if (it != index_.end()) {
+        unlinkAndErase(it->second.get());
+      }
+      ++stats_.rejections;
+      return false;
+    }
+    ++stats_.insertions;
+    if (it != index_.end()) {
+      page_cache_detail::Page* page = it->second.get();
+      listOf(page).remove(page);
+      page->body   = std::move(body);
+      page->charge = charge;
+      listOf(page).pushFront(page);
+      demoteProtected();
+    } else {
+      auto page     = std::make_unique<page_cache_detail::Page>();
+      page->url     = std::move(url);
+      page->body    = std::move(body);
+      page->charge  = charge;
+      page->segment = kWindow;
+      window_.pushFront(page.get());
+      const std::string_view key = page->url;
+      index_.emplace(key, std::move(page));
+      sketch_.ensureCapacity(index_.size());
+    }
+    evictOverBudget();
+    return true;
+  }
+
+  auto erase(std::string_view url) -> bool {
+    const auto it = index_.find(url);
+    if (it == index_.end()) {
+      return false;
+    }
+    unlinkAndErase(it->second.get());
+    return true;
+  }
+
+  // 统计保留，频率记录清空
+  void clear() {
+    window_.reset();
+    probation_.reset();
+    protected_.reset();
+    page_cache_detail::PageIndex().swap(index_);
+    sketch_.clear();
+  }
+
+  void setBudget(size_t byteBudget) {
+    budget_          = byteBudget;
+    windowBudget_    = byteBudget / 100;
+    mainBudget_      = byteBudget - windowBudget_;
+    protectedBudget_ = mainBudget_ / 5 * 4;
+    demoteProtected();
+    evictOverBudget();
+  }
+
+  [[nodiscard]] auto size() const -> size_t { return index_.size(); }
+  [[nodiscard]] auto bytes() const -> size_t {
+    return window_.bytes() + probation_.bytes() + protected_.bytes();
+  }
+  [[nodiscard]] auto budget() const -> size_t { return budget_; }
+  [[nodiscard]] auto stats() const -> const CacheStats& { return stats_; }
+  void resetStats() { stats_ = {}; }
+
+  private:
+  enum : uint8_t
+  {
+    kWindow,
+    kProbation,
+    kProtected,
+  };
+
+  size_t                       budget_          = 0;
+  size_t                       windowBudget_    = 0;
+  size_t                       mainBudget_      = 0;
+  size_t                       protectedBudget_ = 0;
+  page_cache_detail::LruList   window_;
+  page_cache_detail::LruList   probation_;
+  page_cache_detail::LruList   protected_;
+  page_cache_detail::PageIndex index_;
+  FrequencySketch              sketch_;
+  CacheStats                   stats_;
+
+  static auto hashOf(std::string_view url) -> uint64_t {
+    return std::hash<std::string_view>{}(url);
+  }
+
+  auto listOf(const page_cache_detail::Page* page) -> page_cache_detail::LruList& {
+    switch (page->segment) {
+      case kWindow: return window_;
+      case kProbation: return probation_;
+      default: return protected_;
+    }
+  }
+
+  [[nodiscard]] auto mainBytes() const -> size_t { return probation_.bytes() + protected_.bytes(); }
+
+  void promote(page_cache_detail::Page* page) {
+    if (page->segment != kProbation) {
+      listOf(page).moveToFront(page);
+      return;
+    }
+    probation_.remove(page);
+    page->segment = kProtected;
+    protected_.pushFront(page);
+    demoteProtected();
+  }
+
+  void demoteProtected() {
+    while (protected_.bytes() > protectedBudget_) {
+      page_cache_detail::Page* page = protected_.back();
+      protected_.remove(page);
+      page->segment = kProbation;
+      probation_.pushFront(page);
+    }
+  }
+
+  void unlinkAndErase(page_cache_detail::Page* page) {
+    listOf(page).remove(page);
+    index_.erase(index_.find(page->url));
+  }
+
+  // 主区最久未使用的页面：先找试用区
+  [[nodiscard]] auto victim() const -> page_cache_detail::Page* {
+    return probation_.empty() ? protected_.back() : probation_.back();
+  }
+
+  void evictOverBudget() {
+    while (window_.bytes() > windowBudget_) {
+      page_cache_detail::Page* candidate = window_.back();
+      window_.remove(candidate);
+      admit(candidate);
+    }
+    // 替换内容或缩小预算后主区可能超出预算
+    while (mainBytes() > mainBudget_) {
+      unlinkAndErase(victim());
+      ++stats_.evictions;
+    }
+  }
+
+  // candidate 已经离开窗口：频率高于主区的淘汰对象才能进入试用区，否则淘汰 candidate。
+  // setBudget() 缩小预算后 candidate 可能比整个主区还大，这时直接淘汰，不清空主区
+  void admit(page_cache_detail::Page* candidate) {
+    if (candidate->charge > mainBudget_) {
+      index_.erase(index_.find(candidate->url));
+      ++stats_.evictions;
+      return;
+    }
+    const uint32_t frequency = sketch_.estimate(hashOf(candidate->url));
+    while (mainBytes() + candidate->charge > mainBudget_) {
+      page_cache_detail::Page* page = victim();
+      if (page == nullptr || frequency <= sketch_.estimate(hashOf(page->url))) {
+        index_.erase(index_.find(candidate->url));
+        ++stats_.evictions;
+        return;
+      }
+      unlinkAndErase(page);
+      ++stats_.evictions;
+    }
+    candidate->segment = kProbation;
+    probation_.pushFront(candidate);
+  }
+};
+
+#endif
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <memory>
 
+#include "cow_buffer.h"
 
 class BadCase {
   public:
@@ -71,6 +72,25 @@ class GoodCase {
   size_t size_;
 };
 
+// 引用计数 + 写时复制：拷贝时共享内存，第一次写入时才真正复制
+class CowCase {
+  public:
+  CowCase(size_t size)
+    : data_(size) {}
+
+  // 拷贝构造、拷贝赋值和析构都交给 CowBuffer 处理引用计数
+
+  [[nodiscard]] auto get(size_t i) const -> int { return data_[i]; }
+  auto               set(size_t i, int value) -> void { data_.set(i, value); }
+
+  [[nodiscard]] auto sharesDataWith(const CowCase& other) const -> bool {
+    return data_.sharesDataWith(other.data_);
+  }
+
+  private:
+  CowBuffer<int> data_;
+};
+
 auto main() -> int {
   GoodCase m1(10);
   // 调用拷贝构造函数，为 m2 分配新的内存并复制 m1 的数据
@@ -88,5 +108,17 @@ auto main() -> int {
   if (m11.sharesDataWith(m22)) {
     std::cout << "m11 has the same memory address with m22" << std::endl;
   }
+
+  // 写时复制：m4 与 m3 共享内存，直到 m4 第一次写入
+  CowCase m3(10);
+  CowCase m4(m3);
+  if (m3.sharesDataWith(m4)) {
+    std::cout << "m3 shares memory with m4 before writing" << std::endl;
+  }
+  m4.set(0, 42);
+  if (!m3.sharesDataWith(m4)) {
+    std::cout << "m4 got its own copy after writing: " << m3.get(0) << " vs " << m4.get(0)
+              << std::endl;
+  }
   return 0;
 }
\ No newline at end of file
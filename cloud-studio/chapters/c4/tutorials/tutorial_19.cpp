@@ -12,16 +12,53 @@
  * 6. 运算符重载
  */
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "account_status.h"
+#include "atomic_account.h"
+#include "buffer_pool.h"
+#include "garage.h"
+#include "money.h"
+#include "name_table.h"
+#include "units.h"
+
 // 前向声明
 class Engine;
 class Wheel;
 
+/**
+ * @brief ResourceManager 的名字：驻留的基础名字 + 拷贝代数
+ * 每拷贝一次只把 copies 加一，不再拼接出越来越长的 "xxx_copy_copy..." 字符串；
+ * 输出时才展开成原来的样子。
+ */
+struct ResourceName {
+  Symbol   base;
+  uint32_t copies = 0;
+
+  [[nodiscard]] auto copied() const -> ResourceName { return {base, copies + 1}; }
+
+  friend auto operator==(const ResourceName& a, const ResourceName& b) -> bool {
+    return a.base == b.base && a.copies == b.copies;
+  }
+  friend auto operator!=(const ResourceName& a, const ResourceName& b) -> bool { return !(a == b); }
+
+  friend auto operator<<(std::ostream& os, const ResourceName& name) -> std::ostream& {
+    os << name.base;
+    for (uint32_t i = 0; i < name.copies; ++i) {
+      os << "_copy";
+    }
+    return os;
+  }
+};
+
 /**
  * @brief 演示资源管理的基础类
  * 展示：
@@ -31,30 +68,35 @@ class Wheel;
  */
 class ResourceManager {
   public:
+  static constexpr size_t kDataSize = 100;
+  // 定长缓冲区从线程局部的回收池中取，创建/销毁不必每次都走 malloc
+  using DataPool = FixedBufferPool<kDataSize * sizeof(int)>;
+
   // 构造函数：初始化资源
+  // 只有第一次出现的名字需要写入名字表
   explicit ResourceManager(const std::string& name)
-    : name_(name)
-    , data_(new int[100]) {
+    : name_{intern(name)}
+    , data_(acquireData()) {
     std::cout << "ResourceManager构造：" << name_ << std::endl;
   }
 
   // 析构函数：释放资源
   ~ResourceManager() {
     std::cout << "ResourceManager析构：" << name_ << std::endl;
-    delete[] data_;
+    DataPool::release(data_);
   }
 
   // 拷贝构造函数：深拷贝
   ResourceManager(const ResourceManager& other)
-    : name_(other.name_ + "_copy")
-    , data_(new int[100]) {
-    std::copy(other.data_, other.data_ + 100, data_);
+    : name_(other.name_.copied())
+    , data_(acquireData()) {
+    std::copy(other.data_, other.data_ + kDataSize, data_);
     std::cout << "ResourceManager拷贝构造：" << name_ << std::endl;
   }
 
   // 移动构造函数：转移资源所有权
   ResourceManager(ResourceManager&& other) noexcept
-    : name_(std::move(other.name_))
+    : name_(std::exchange(other.name_, ResourceName()))
     , data_(other.data_) {
     other.data_ = nullptr;   // 防止double-free
     std::cout << "ResourceManager移动构造：" << name_ << std::endl;
@@ -63,10 +105,12 @@ class ResourceManager {
   // 拷贝赋值运算符：深拷贝
   auto operator=(const ResourceManager& other) -> ResourceManager& {
     if (this != &other) {   // 自赋值检查
-      delete[] data_;
-      data_ = new int[100];
-      std::copy(other.data_, other.data_ + 100, data_);
-      name_ = other.name_ + "_copy";
+      // 缓冲区大小固定，已有缓冲区（被移动走之前）直接复用
+      if (data_ == nullptr) {
+        data_ = acquireData();
+      }
+      std::copy(other.data_, other.data_ + kDataSize, data_);
+      name_ = other.name_.copied();
     }
     std::cout << "ResourceManager拷贝赋值：" << name_ << std::endl;
     return *this;
@@ -75,18 +119,27 @@ class ResourceManager {
   // 移动赋值运算符：转移资源所有权
   auto operator=(ResourceManager&& other) noexcept -> ResourceManager& {
     if (this != &other) {
-      delete[] data_;
+      DataPool::release(data_);
       data_       = other.data_;
       other.data_ = nullptr;
-      name_       = std::move(other.name_);
+      name_       = std::exchange(other.name_, ResourceName());
     }
     std::cout << "ResourceManager移动赋值：" << name_ << std::endl;
     return *this;
   }
 
+  [[nodiscard]] auto name() const -> const ResourceName& { return name_; }
+
+  // 名字比较只比较两个整数
+  [[nodiscard]] auto sameNameAs(const ResourceManager& other) const -> bool {
+    return name_ == other.name_;
+  }
+
   private:
-  std::string name_;
-  int*        data_;   // 模拟动态资源
+  ResourceName name_;
+  int*         data_;   // 模拟动态资源
+
+  static auto acquireData() -> int* { return static_cast<int*>(DataPool::acquire()); }
 };
 
 /**
@@ -99,104 +152,64 @@ class ResourceManager {
 class BankAccount {
   public:
   // 构造函数确保初始状态有效
-  explicit BankAccount(double initialBalance) {
-    if (initialBalance < 0) {
+  explicit BankAccount(Money initialBalance) {
+    if (initialBalance.isNegative()) {
       throw std::invalid_argument("初始余额不能为负数");
     }
     balance_ = initialBalance;
   }
 
-  // setter函数维护不变性
-  void deposit(double amount) {
-    if (amount <= 0) {
+  // setter函数维护不变性；tryXxx 用错误码报告常规的失败，不抛异常
+  [[nodiscard]] auto tryDeposit(Money amount) noexcept -> AccountStatus {
+    if (!amount.isPositive()) {
+      return AccountStatus::InvalidAmount;
+    }
+    if (!Money::tryAdd(balance_, amount, balance_)) {
+      return AccountStatus::Overflow;   // 溢出时余额保持不变
+    }
+    return AccountStatus::Ok;
+  }
+
+  [[nodiscard]] auto tryWithdraw(Money amount) noexcept -> AccountStatus {
+    if (!amount.isPositive()) {
+      return AccountStatus::InvalidAmount;
+    }
+    if (amount > balance_) {
+      return AccountStatus::InsufficientFunds;
+    }
+    balance_ = Money::fromMinor(balance_.minor() - amount.minor());
+    return AccountStatus::Ok;
+  }
+
+  // 抛异常的版本只是一层包装
+  void deposit(Money amount) {
+    const AccountStatus status = tryDeposit(amount);
+    if (status == AccountStatus::InvalidAmount) {
       throw std::invalid_argument("存款金额必须为正数");
     }
-    balance_ += amount;
+    if (status == AccountStatus::Overflow) {
+      throw std::overflow_error("余额溢出");
+    }
   }
 
-  void withdraw(double amount) {
-    if (amount <= 0) {
+  void withdraw(Money amount) {
+    const AccountStatus status = tryWithdraw(amount);
+    if (status == AccountStatus::InvalidAmount) {
       throw std::invalid_argument("取款金额必须为正数");
     }
-    if (balance_ - amount < 0) {
+    if (status == AccountStatus::InsufficientFunds) {
       throw std::runtime_error("余额不足");
     }
-    balance_ -= amount;
   }
 
   // getter返回当前状态
-  [[nodiscard]] auto getBalance() const -> double { return balance_; }
+  [[nodiscard]] auto getBalance() const -> Money { return balance_; }
 
   private:
-  double balance_;   // 不变性：余额永远不能为负
-};
-
-/**
- * @brief 演示继承关系的基类
- * 展示：
- * - 虚函数
- * - 纯虚函数
- * - protected成员
- */
-class Vehicle {
-  public:
-  virtual ~Vehicle() = default;   // 虚析构函数
-
-  // 纯虚函数：定义接口
-  virtual void start() = 0;
-  virtual void stop()  = 0;
-
-  // 虚函数：可以被重写
-  virtual void accelerate() { std::cout << "Vehicle加速" << std::endl; }
-
-  // 非虚函数：不应被重写
-  void park() { std::cout << "Vehicle停车" << std::endl; }
-
-  protected:
-  // 保护成员：派生类可访问
-  bool engineRunning_ = false;
+  Money balance_;   // 不变性：余额永远不能为负
 };
 
-/**
- * @brief 演示"is-a"关系的派生类
- * Car "is-a" Vehicle
- */
-class Car : public Vehicle {
-  public:
-  // 实现纯虚函数
-  void start() override {
-    std::cout << "Car启动" << std::endl;
-    engineRunning_ = true;
-  }
-
-  void stop() override {
-    std::cout << "Car停止" << std::endl;
-    engineRunning_ = false;
-  }
-
-  // 重写虚函数
-  void accelerate() override { std::cout << "Car加速" << std::endl; }
-};
-
-/**
- * @brief 演示"has-a"关系的类
- * Garage有多个Vehicle
- */
-class Garage {
-  public:
-  // 添加车辆
-  void addVehicle(std::unique_ptr<Vehicle> vehicle) { vehicles_.push_back(std::move(vehicle)); }
-
-  // 启动所有车辆
-  void startAllVehicles() {
-    for (const auto& vehicle : vehicles_) {
-      vehicle->start();   // 多态调用
-    }
-  }
-
-  private:
-  std::vector<std::unique_ptr<Vehicle>> vehicles_;   // has-a关系
-};
+// 继承关系（is-a 和 has-a）：Vehicle、Car、Garage 见 garage.h
 
 /**
  * @brief 演示类型转换的类
@@ -213,14 +226,18 @@ class Distance {
 
   // 转换运算符：从Distance到double
   explicit operator double() const {
-    return meters_ / 1000.0;   // 转换为千米
+    // 转换为千米：换算系数在编译期折叠，运行时只有一次乘法
+    return units::quantity_cast<units::Kilometers>(meters_).count();
   }
 
   // 常规成员函数
-  [[nodiscard]] auto getMeters() const -> int { return meters_; }
+  [[nodiscard]] auto getMeters() const -> int { return meters_.count(); }
+
+  // 带单位的长度：可以与千米、英里直接运算，量纲不同时编译不过
+  [[nodiscard]] auto length() const -> units::Meters { return meters_; }
 
   private:
-  int meters_;
+  units::Quantity<units::Length, std::ratio<1>, int> meters_;
 };
 
 // 主函数：演示各种概念
@@ -232,25 +249,65 @@ int main() {
     ResourceManager rm2 = std::move(rm1);   // 移动构造
     ResourceManager rm3("Another");
     rm3 = std::move(rm2);   // 移动赋值
+    {
+      ResourceManager rm4(rm3);   // 拷贝构造：复用 rm3 在移动赋值时归还给池的缓冲区
+    }
+    ResourceManager rm5(rm3);
+    const PoolStats poolStats = ResourceManager::DataPool::globalStats();
+    std::cout << "缓冲池命中率：" << poolStats.hitRate() * 100 << "%，空闲块："
+              << poolStats.cached << "，使用中：" << poolStats.outstanding() << std::endl;
+    ResourceManager rm6(rm3);   // 拷贝不写名字表，名字比较是整数比较
+    std::cout << "rm5 与 rm6 同名：" << std::boolalpha << rm5.sameNameAs(rm6)
+              << "，名字表中有 " << NameTable::instance().size() << " 个名字" << std::endl;
 
     // 2. 合法值和不变性演示
     std::cout << "\n=== 合法值演示 ===" << std::endl;
-    BankAccount account(1000.0);
-    account.deposit(500.0);
-    account.withdraw(200.0);
+    BankAccount account(Money::units(1000));
+    account.deposit(Money::units(500));
+    account.withdraw(Money::fromDouble(200.25));
     std::cout << "当前余额: " << account.getBalance() << std::endl;
 
     try {
-      account.withdraw(2000.0);   // 将抛出异常
+      account.withdraw(Money::units(2000));   // 将抛出异常
     } catch (const std::runtime_error& e) {
       std::cout << "预期的异常：" << e.what() << std::endl;
     }
 
+    // 多个线程同时存取款：余额以分为单位保存在原子变量中，取款用 CAS 保证不会透支
+    AtomicBankAccount        shared(Money::units(1000));
+    std::atomic<int>         rejected{0};
+    std::vector<std::thread> tellers;
+    for (int t = 0; t < 4; ++t) {
+      tellers.emplace_back([&shared, &rejected] {
+        for (int i = 0; i < 1000; ++i) {
+          shared.deposit(Money::units(1));
+          if (shared.tryWithdraw(Money::units(3)) != AccountStatus::Ok) {
+            ++rejected;
+          }
+        }
+      });
+    }
+    for (auto& teller : tellers) {
+      teller.join();
+    }
+    std::cout << "并发存取款后余额: " << shared.getBalance() << "，被拒绝的取款: " << rejected
+              << std::endl;
+
     // 3. 继承和多态演示
     std::cout << "\n=== 继承和多态演示 ===" << std::endl;
     Garage garage;
     garage.addVehicle(std::make_unique<Car>());
+    garage.emplaceVehicle<Car>();   // 就地构造，与其他 Car 连续存放
     garage.startAllVehicles();
+    std::cout << "车库中共有 " << garage.vehicleCount() << " 辆车" << std::endl;
+
+    // 异步停车：立即返回，可以查询每辆车的状态；Car 会输出日志，这里一次只停一辆
+    FleetOptions options;
+    options.concurrency     = 1;
+    FleetOperation stopping = garage.stopAll(options);
+    stopping.wait();
+    std::cout << "已停车 " << stopping.completed() << "/" << stopping.total()
+              << "，最慢一辆耗时 " << stopping.latencies().max() / 1000 << " 微秒" << std::endl;
 
     // 4. 类型转换演示
     std::cout << "\n=== 类型转换演示 ===" << std::endl;
@@ -258,6 +315,13 @@ int main() {
     double   km = static_cast<double>(dist);   // 显式转换
     std::cout << dist.getMeters() << "米 = " << km << "千米" << std::endl;
 
+    // 单位是类型的一部分：米、千米、英里相加时自动换算，米与秒相加编译不过
+    using namespace units::literals;
+    const units::Kilometers   total = dist.length() + 2_km + 1_mi;
+    const units::MilesPerHour speed = units::quantity_cast<units::MilesPerHour>(total / 0.5_h);
+    std::cout << "总里程 " << total.count() << " 千米，半小时跑完的速度 " << speed.count()
+              << " 英里/小时" << std::endl;
+
   } catch (const std::exception& e) {
     std::cerr << "错误：" << e.what() << std::endl;
     return 1;
@@ -1,41 +1,13 @@
 #include <iostream>
 #include <string>
 
-class Rational {
-  public:
-  // 构造函数不声明为explicit，允许隐式转换
-  Rational(int numerator = 0, int denominator = 1)
-    : n(numerator)
-    , d(denominator) {
-    std::cout << "Rational(" << n << "/" << d << ") constructed\n";
-  }
-
-  // 拷贝构造函数
-  Rational(const Rational& other)
-    : n(other.n)
-    , d(other.d) {
-    std::cout << "Rational(" << n << "/" << d << ") copied\n";
-  }
-
-  // 析构函数
-  ~Rational() { std::cout << "Rational(" << n << "/" << d << ") destroyed\n"; }
-
-  // 打印函数
-  void print() const { std::cout << n << "/" << d; }
-
-  private:
-  int n, d;   // 分子(numerator)和分母(denominator)
-
-  // 声明为友元，允许访问私有成员
-  friend auto operator*(const Rational& lhs, const Rational& rhs) -> const Rational;
-  friend auto badMultiplyStack(const Rational& lhs, const Rational& rhs) -> const Rational&;
-  friend auto badMultiplyHeap(const Rational& lhs, const Rational& rhs) -> const Rational&;
-};
-
-// 正确实现：返回一个新对象
-inline auto operator*(const Rational& lhs, const Rational& rhs) -> const Rational {
-  std::cout << "\nCalling operator*\n";
-  return Rational(lhs.n * rhs.n, lhs.d * rhs.d);
+#include "counted_rational.h"
+
+// 打印 scope 创建以来 Rational 的构造、拷贝、移动、析构次数
+void printCounts(const LifecycleScope<Rational>& scope) {
+  const LifecycleCounts counts = scope.diff();
+  std::cout << "  constructed: " << counts.constructed << ", copied: " << counts.copied
+            << ", moved: " << counts.moved << ", destroyed: " << counts.destroyed << "\n";
 }
 
 // 错误实现1：返回栈上对象的引用
@@ -60,7 +32,9 @@ void demonstrateGoodMultiply() {
   Rational b(3, 4);   // 3/4
 
   std::cout << "\nMultiplying a * b:\n";
-  Rational c = a * b;   // 调用operator*
+  LifecycleScope<Rational> scope;
+  Rational                 c = a * b;   // 调用operator*，返回值直接构造在 c 中
+  printCounts(scope);                   // 只构造了一次，没有拷贝和移动
 
   std::cout << "\nResult: ";
   c.print();
@@ -73,7 +47,9 @@ void demonstrateBadStackMultiply() {
   Rational b(3, 4);   // 3/4
 
   std::cout << "\nMultiplying a * b using badMultiplyStack:\n";
-  const Rational& c = badMultiplyStack(a, b);   // 危险！
+  LifecycleScope<Rational> scope;
+  const Rational&          c = badMultiplyStack(a, b);   // 危险！
+  printCounts(scope);   // 构造一次、析构一次：c 引用的对象已经不存在了
 
   std::cout << "\nTrying to use the result: ";
   c.print();   // 未定义行为：访问已销毁对象
@@ -86,7 +62,9 @@ void demonstrateBadHeapMultiply() {
   Rational b(3, 4);   // 3/4
 
   std::cout << "\nMultiplying a * b using badMultiplyHeap:\n";
-  const Rational& c = badMultiplyHeap(a, b);   // 内存泄漏！
+  LifecycleScope<Rational> scope;
+  const Rational&          c = badMultiplyHeap(a, b);   // 内存泄漏！
+  printCounts(scope);   // 构造一次，没有析构
 
   std::cout << "\nResult exists but leaks memory: ";
   c.print();
@@ -96,6 +74,7 @@ void demonstrateBadHeapMultiply() {
 
 auto main() -> int {
   std::cout << "Demonstrating different ways to return objects:\n";
+  LifecycleScope<Rational> total;
 
   // 1. 演示正确的实现
   demonstrateGoodMultiply();
@@ -106,5 +85,7 @@ auto main() -> int {
   // 3. 演示错误的堆实现（导致内存泄漏）
   demonstrateBadHeapMultiply();
 
+  // badMultiplyHeap 创建的对象没有被释放
+  std::cout << "\nRational objects still alive: " << total.diff().live() << "\n";
   return 0;
 }
@@ -1,6 +1,14 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include "account_ledger.h"
+#include "bank_account.h"
+#include "money.h"
 
 // 反面教材：公开成员变量
 class BadPerson {
@@ -56,7 +64,7 @@ class Person {
 // 正面教材：展示实现的灵活性
 class Employee {
   public:
-  Employee(std::string name, double baseSalary)
+  Employee(std::string name, Money baseSalary)
     : name_(std::move(name))
     , baseSalary_(baseSalary) {}
 
@@ -64,66 +72,26 @@ class Employee {
   [[nodiscard]] auto getName() const -> const std::string& { return name_; }
 
   // 计算实际工资（可以随时改变实现而不影响客户端代码）
-  [[nodiscard]] auto getCurrentSalary() const -> double { return baseSalary_ * (1.0 + bonusRate_); }
+  // 工资和奖金率都改成了定点数，调用方的写法不变
+  [[nodiscard]] auto getCurrentSalary() const -> Money {
+    return baseSalary_.withRate(bonusBasisPoints_);
+  }
 
-  // 设置奖金率
+  // 设置奖金率，按四舍五入保存为万分比
   auto setBonusRate(double rate) -> void {
-    if (rate < 0.0 || rate > 1.0) {
+    if (!(rate >= 0.0 && rate <= 1.0)) {
       throw std::invalid_argument("Bonus rate must be between 0 and 1");
     }
-    bonusRate_ = rate;
+    bonusBasisPoints_ = std::llround(rate * Money::kRateScale);
   }
 
   private:
   std::string name_;
-  double      baseSalary_;
-  double      bonusRate_ = 0.0;   // 默认无奖金
+  Money       baseSalary_;
+  int64_t     bonusBasisPoints_ = 0;   // 默认无奖金
 };
 
-// 展示如何通过private成员实现更复杂的约束条件
-class BankAccount {
-  public:
-  BankAccount(std::string owner, double initialBalance = 0.0)
-    : owner_(std::move(owner)) {
-    setBalance(initialBalance);
-  }
-
-  // 只读访问
-  [[nodiscard]] auto getOwner() const -> const std::string& { return owner_; }
-  [[nodiscard]] auto getBalance() const -> double { return balance_; }
-
-  // 存款操作
-  auto deposit(double amount) -> void {
-    if (amount <= 0) {
-      throw std::invalid_argument("Deposit amount must be positive");
-    }
-    setBalance(balance_ + amount);
-  }
-
-  // 取款操作
-  auto withdraw(double amount) -> void {
-    if (amount <= 0) {
-      throw std::invalid_argument("Withdrawal amount must be positive");
-    }
-    if (amount > balance_) {
-      throw std::runtime_error("Insufficient funds");
-    }
-    setBalance(balance_ - amount);
-  }
-
-  private:
-  std::string owner_;
-  double      balance_ = 0.0;
-
-  // 私有辅助函数，确保余额更新的一致性
-  auto setBalance(double newBalance) -> void {
-    if (newBalance < 0) {
-      throw std::invalid_argument("Balance cannot be negative");
-    }
-    balance_ = newBalance;
-    // 这里可以添加其他逻辑，如记录交易、通知观察者等
-  }
-};
+// 展示如何通过private成员实现更复杂的约束条件：BankAccount（见 bank_account.h）
 
 auto main() -> int {
   try {
@@ -140,24 +108,57 @@ auto main() -> int {
     }
 
     // 使用Employee类
-    Employee emp("Bob", 5000);
+    Employee emp("Bob", Money::units(5000));
     emp.setBonusRate(0.1);   // 10%的奖金
     std::cout << emp.getName() << "'s current salary: " << emp.getCurrentSalary() << "\n";
 
     // 使用BankAccount类
-    BankAccount account("Charlie", 1000);
-    account.deposit(500);
+    BankAccount account("Charlie", Money::units(1000));
+    account.deposit(Money::fromDouble(500.10));
     std::cout << "After deposit: " << account.getBalance() << "\n";
 
-    account.withdraw(300);
+    account.withdraw(Money::units(300));
     std::cout << "After withdrawal: " << account.getBalance() << "\n";
 
     try {
-      account.withdraw(2000);   // 会抛出异常
+      account.withdraw(Money::units(2000));   // 会抛出异常
     } catch (const std::exception& e) {
       std::cout << "验证取款：" << e.what() << "\n";
     }
 
+    // 不抛异常的版本：余额不足是常规情况，直接检查返回的错误码
+    if (const AccountStatus status = account.tryWithdraw(Money::units(2000));
+        status != AccountStatus::Ok) {
+      std::cout << "tryWithdraw: " << toString(status) << "\n";
+    }
+
+    // 写前日志：余额修改先写入日志再生效，“崩溃”后重放日志恢复余额
+    const std::string journalPath = "tutorial_22.journal";
+    std::remove(journalPath.c_str());
+    {
+      AccountJournal journal(journalPath, Durability::GroupSync);
+      BankAccount    saver("Dana", Money::units(100));
+      saver.attachJournal(&journal);
+      saver.deposit(Money::units(50));
+      saver.withdraw(Money::fromDouble(30.5));
+    }   // saver 随作用域销毁，只剩下日志
+    const auto recovered = AccountJournal::recoverBalances(journalPath);
+    std::cout << "Recovered Dana: " << recovered.at("Dana") << "\n";
+    std::remove(journalPath.c_str());
+
+    // 大量账户：余额集中存放在按编号分片的账本里，交易成批应用
+    AccountLedger            ledger(1'000, 8);
+    std::vector<Transaction> batch = {
+      Transaction::deposit(1, 10'000),
+      Transaction::transfer(1, 900, 2'500),   // 跨分片转账，两个分片同时加锁
+      Transaction::withdraw(900, 5'000),      // 余额不足
+    };
+    std::vector<AccountStatus> results(batch.size());
+    const size_t               applied = ledger.apply(batch, results.data());
+    std::cout << "Ledger applied " << applied << "/" << batch.size()
+              << ", last: " << toString(results.back()) << ", account 900: " << ledger.balance(900)
+              << "\n";
+
   } catch (const std::exception& e) {
     std::cerr << "Error: " << e.what() << "\n";
     return 1;
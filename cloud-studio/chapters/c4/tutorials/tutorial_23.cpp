@@ -1,26 +1,41 @@
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "sharded_page_cache.h"
+#include "tiny_lfu_cache.h"
+
 // 命名空间用于组织相关的类和函数
 namespace WebBrowserStuff {
 
+// 模拟下载：页面大小由 URL 决定（4～20KB）
+inline auto downloadPage(const std::string& url) -> std::string {
+  const size_t kb = 4 + std::hash<std::string>{}(url) % 17;
+  return std::string(kb * 1024, 'x');
+}
+
 /**
  * WebBrowser类：模拟一个网页浏览器的基本功能
  * 包含了核心功能如缓存、历史记录和Cookie管理
  */
 class WebBrowser {
   public:
-  // 构造函数：初始化浏览器的基本状态
-  WebBrowser()
-    : cacheSize_(0)
+  // 构造函数：初始化浏览器的基本状态，页面缓存最多占用 cacheBudget 字节
+  explicit WebBrowser(size_t cacheBudget = 64 * 1024)
+    : cache_(cacheBudget)
     , historyEntryCount_(0)
     , cookieCount_(0) {}
 
   // 核心功能：清除缓存
   void clearCache() {
-    std::cout << "Clearing " << cacheSize_ << "MB of cache..." << std::endl;
-    cacheSize_ = 0;
+    std::cout << "Clearing " << cache_.size() << " pages (" << cache_.bytes()
+              << " bytes) of cache..." << std::endl;
+    cache_.clear();
   }
 
   // 核心功能：清除历史记录
@@ -35,26 +50,37 @@ class WebBrowser {
     cookieCount_ = 0;
   }
 
-  // 模拟浏览网页，增加各种数据
+  // 模拟浏览网页：先查缓存，未命中时下载并放进缓存
   void browseWebPage(const std::string& url) {
-    std::cout << "Browsing: " << url << std::endl;
-    cacheSize_ += 10;          // 假设每个页面产生10MB缓存
+    if (cache_.get(url) != nullptr) {
+      std::cout << "Browsing: " << url << " (cached)" << std::endl;
+    } else {
+      std::string page = downloadPage(url);
+      std::cout << "Browsing: " << url << " (downloaded " << page.size() << " bytes)" << std::endl;
+      cache_.put(url, std::move(page));
+    }
     historyEntryCount_ += 1;   // 增加一条历史记录
     cookieCount_ += 2;         // 假设每个页面产生2个cookie
   }
 
+  // 缓存的命中、淘汰统计
+  [[nodiscard]] auto cacheStats() const -> const CacheStats& { return cache_.stats(); }
+
   // Getter函数用于展示当前状态
   void showStatus() const {
+    const CacheStats& stats = cache_.stats();
     std::cout << "Browser Status:\n"
-              << "Cache Size: " << cacheSize_ << "MB\n"
+              << "Cache: " << cache_.size() << " pages, " << cache_.bytes() << "/"
+              << cache_.budget() << " bytes (hits " << stats.hits << ", misses " << stats.misses
+              << ", evictions " << stats.evictions << ")\n"
               << "History Entries: " << historyEntryCount_ << "\n"
               << "Cookies: " << cookieCount_ << "\n";
   }
 
   private:
-  int cacheSize_;           // 缓存大小（MB）
-  int historyEntryCount_;   // 历史记录数量
-  int cookieCount_;         // Cookie数量
+  TinyLfuPageCache cache_;               // URL -> 页面内容，按字节预算淘汰，按访问频率准入
+  int              historyEntryCount_;   // 历史记录数量
+  int              cookieCount_;         // Cookie数量
 };
 
 // 非成员函数：一次性清除所有浏览数据
@@ -90,6 +116,64 @@ void clearBrowserAndReport(WebBrowser& wb) {
   wb.showStatus();
 }
 
+/**
+ * ConcurrentWebBrowser：多个工作线程同时调用 browseWebPage 的版本
+ * 缓存按 URL 哈希分片，每个分片一把锁、各自做 LRU 淘汰；计数器是原子变量
+ */
+class ConcurrentWebBrowser {
+  public:
+  // 每个分片的预算是 cacheBudget / shards，要远大于单个页面
+  explicit ConcurrentWebBrowser(size_t cacheBudget = 1024 * 1024, size_t shards = 8)
+    : cache_(cacheBudget, shards) {}
+
+  // 逐个分片清空，其他线程可以继续浏览
+  void clearCache() {
+    std::cout << "Clearing " << cache_.size() << " pages of cache in " << cache_.shardCount()
+              << " shards..." << std::endl;
+    cache_.clear();
+  }
+
+  void clearHistory() {
+    std::cout << "Clearing " << historyEntryCount_.exchange(0) << " history entries..."
+              << std::endl;
+  }
+
+  void removeCookies() {
+    std::cout << "Removing " << cookieCount_.exchange(0) << " cookies..." << std::endl;
+  }
+
+  // 可以在多个线程中同时调用；不打印日志，避免所有线程在 std::cout 上排队
+  void browseWebPage(const std::string& url) {
+    if (!cache_.visit(url, [](const std::string&) {})) {
+      cache_.put(url, downloadPage(url));
+    }
+    historyEntryCount_.fetch_add(1, std::memory_order_relaxed);
+    cookieCount_.fetch_add(2, std::memory_order_relaxed);
+  }
+
+  void showStatus() const {
+    const CacheStats stats = cache_.stats();
+    std::cout << "Browser Status:\n"
+              << "Cache: " << cache_.size() << " pages, " << cache_.bytes() << "/"
+              << cache_.budget() << " bytes (hits " << stats.hits << ", misses " << stats.misses
+              << ", evictions " << stats.evictions << ")\n"
+              << "History Entries: " << historyEntryCount_.load() << "\n"
+              << "Cookies: " << cookieCount_.load() << "\n";
+  }
+
+  private:
+  ShardedPageCache cache_;
+  std::atomic<int> historyEntryCount_{0};
+  std::atomic<int> cookieCount_{0};
+};
+
+// 同名的非成员函数可以直接重载，WebBrowser 的代码不需要任何改动
+void clearBrowser(ConcurrentWebBrowser& wb) {
+  wb.clearCache();
+  wb.clearHistory();
+  wb.removeCookies();
+}
+
 }   // namespace WebBrowserStuff
 
 // 演示代码
@@ -99,13 +183,36 @@ auto main() -> int {
   // 创建浏览器实例
   WebBrowser browser;
 
-  // 模拟浏览几个网页
+  // 模拟浏览几个网页；再次访问时命中缓存。超出 64KB 时，只访问过一次的新页面
+  // 不会挤掉访问过两次的 example.com
   browser.browseWebPage("https://www.example.com");
   browser.browseWebPage("https://www.google.com");
   browser.browseWebPage("https://www.github.com");
+  browser.browseWebPage("https://www.example.com");
+  browser.browseWebPage("https://www.wikipedia.org");
+  browser.browseWebPage("https://www.cppreference.com");
+  browser.browseWebPage("https://www.google.com");
 
   // 使用非成员函数来清理浏览器
   clearBrowserAndReport(browser);
 
+  // 4 个线程同时浏览 50 个网站，每个线程访问 100 次
+  std::cout << "\n=== Concurrent Browsing ===" << std::endl;
+  ConcurrentWebBrowser     shared;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 4; ++t) {
+    workers.emplace_back([&shared, t] {
+      for (int i = 0; i < 100; ++i) {
+        shared.browseWebPage("https://site-" + std::to_string((i * 7 + t) % 50) + ".com");
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  shared.showStatus();
+  clearBrowser(shared);
+  shared.showStatus();
+
   return 0;
 }
\ No newline at end of file
@@ -1,11 +1,15 @@
 #include <iostream>
 #include <string>
 
+#include "big_rational.h"
+#include "rational.h"
+#include "rational_array.h"
+
 // 第一种实现：使用成员函数的乘法运算符（存在限制）
 class RationalMember {
   public:
-  // 构造函数：允许隐式转换
-  RationalMember(int numerator = 0, int denominator = 1)
+  // 构造函数：允许隐式转换；constexpr 对象的分母为 0 时编译失败
+  constexpr RationalMember(int numerator = 0, int denominator = 1)
     : num_(numerator)
     , den_(denominator) {
     if (denominator == 0)
@@ -13,11 +17,11 @@ class RationalMember {
   }
 
   // Getter 函数
-  [[nodiscard]] auto numerator() const -> int { return num_; }
-  [[nodiscard]] auto denominator() const -> int { return den_; }
+  [[nodiscard]] constexpr auto numerator() const -> int { return num_; }
+  [[nodiscard]] constexpr auto denominator() const -> int { return den_; }
 
   // 成员函数版本的乘法运算符
-  auto operator*(const RationalMember& rhs) const -> const RationalMember {
+  constexpr auto operator*(const RationalMember& rhs) const -> const RationalMember {
     return RationalMember(num_ * rhs.num_, den_ * rhs.den_);
   }
 
@@ -32,8 +36,8 @@ class RationalMember {
 // 第二种实现：使用非成员函数的乘法运算符（更灵活）
 class RationalNonMember {
   public:
-  // 构造函数：允许隐式转换
-  RationalNonMember(int numerator = 0, int denominator = 1)
+  // 构造函数：允许隐式转换；constexpr 对象的分母为 0 时编译失败
+  constexpr RationalNonMember(int numerator = 0, int denominator = 1)
     : num_(numerator)
     , den_(denominator) {
     if (denominator == 0)
@@ -41,8 +45,8 @@ class RationalNonMember {
   }
 
   // Getter 函数 - 注意这里使用公有接口而不是友元函数
-  [[nodiscard]] auto numerator() const -> int { return num_; }
-  [[nodiscard]] auto denominator() const -> int { return den_; }
+  [[nodiscard]] constexpr auto numerator() const -> int { return num_; }
+  [[nodiscard]] constexpr auto denominator() const -> int { return den_; }
 
   // 用于打印的辅助函数
   void print() const { std::cout << num_ << "/" << den_; }
@@ -54,7 +58,7 @@ class RationalNonMember {
 
 // 非成员函数版本的乘法运算符
 // 注意：不需要声明为友元，因为只使用公有接口
-auto operator*(const RationalNonMember& lhs, const RationalNonMember& rhs)
+constexpr auto operator*(const RationalNonMember& lhs, const RationalNonMember& rhs)
   -> const RationalNonMember {
   return RationalNonMember(
     lhs.numerator() * rhs.numerator(), lhs.denominator() * rhs.denominator());
@@ -110,11 +114,118 @@ void testNonMemberOperator() {
   std::cout << "\n";
 }
 
+// 测试函数：同样是非成员运算符，但结果始终约分并检查溢出
+void testRational64() {
+  std::cout << "\n=== 测试 Rational64（rational.h）===\n";
+
+  Rational64 half(2, 4);   // 构造时约分为 1/2
+  std::cout << "Rational64(2, 4) = " << half << "\n";
+  std::cout << "2 * half = " << 2 * half << "\n";   // 1，而不是 2/2
+  std::cout << "half + Rational64(1, 3) = " << half + Rational64(1, 3) << "\n";
+
+  // 连乘 40 次 (7/11) * (11/7)：不约分的 int 版本在第 8 次左右溢出，这里始终是 1
+  Rational64 product = 1;
+  for (int i = 0; i < 40; ++i) {
+    product *= Rational64(7, 11);
+    product *= Rational64(11, 7);
+  }
+  std::cout << "40 * ((7/11) * (11/7)) = " << product << "\n";
+
+  try {
+    Rational64       huge(INT64_MAX, 2);
+    const Rational64 result = huge * 4;
+    std::cout << "huge * 4 = " << result << "\n";
+  } catch (const std::overflow_error& e) {
+    std::cout << "huge * 4: " << e.what() << "\n";
+  }
+}
+
+// 编译期常量：构造、约分和运算都在编译期完成，表格直接放在 .rodata 中
+namespace rational_tables {
+
+using namespace rational_literals;
+
+// 长度换算到米
+struct LengthRatio {
+  const char* name;
+  Rational64  toMeter;
+};
+
+constexpr LengthRatio kLengthRatios[] = {
+  {"inch", 254_r / 10000},
+  {"foot", 254_r / 10000 * 12},
+  {"yard", 254_r / 10000 * 36},
+  {"mile", 254_r / 10000 * 63360},
+};
+
+static_assert(kLengthRatios[0].toMeter == Rational64(127, 5000));   // 已约分
+static_assert(kLengthRatios[3].toMeter / kLengthRatios[1].toMeter == 5280);
+// 除数的分子为 INT64_MIN 时也能直接交叉约分
+static_assert(Rational64(0) / Rational64(INT64_MIN) == 0);
+static_assert(Rational64(2) / Rational64(INT64_MIN) == Rational64(-1, INT64_C(1) << 62));
+
+constexpr RationalNonMember kHalf(1, 2);
+static_assert((2 * kHalf).numerator() == 2 && (2 * kHalf).denominator() == 2);   // 不约分
+// constexpr RationalNonMember kBad(1, 0);   // 编译错误：常量求值中抛出异常
+// constexpr Rational64 kBadRatio = 1_r / 0;   // 编译错误：除以 0
+
+}   // namespace rational_tables
+
+void testCompileTimeRational() {
+  std::cout << "\n=== 测试编译期常量（_r 字面量）===\n";
+  for (const auto& unit : rational_tables::kLengthRatios) {
+    std::cout << "1 " << unit.name << " = " << unit.toMeter << " m\n";
+  }
+}
+
+// 测试函数：超出 64 位时自动转为任意精度，回到范围内后恢复内联表示
+void testBigRational() {
+  std::cout << "\n=== 测试 BigRational（big_rational.h）===\n";
+
+  BigRational half(1, 2);
+  std::cout << "2 * half = " << 2 * half << "（内联：" << (2 * half).isInline() << "）\n";
+
+  BigRational harmonic;
+  for (int64_t k = 1; k <= 50; ++k) {
+    harmonic += BigRational(1, k);
+  }
+  std::cout << "1 + 1/2 + ... + 1/50 = " << harmonic << "（内联：" << harmonic.isInline() << "）\n";
+
+  for (int64_t k = 1; k <= 50; ++k) {
+    harmonic -= BigRational(1, k);
+  }
+  std::cout << "逐项减回去 = " << harmonic << "（内联：" << harmonic.isInline() << "）\n";
+}
+
+// 测试函数：列式存储，批量相乘、相加和点积
+void testRationalArray() {
+  std::cout << "\n=== 测试 RationalArray（rational_array.h）===\n";
+
+  RationalArray a;
+  RationalArray b;
+  for (int32_t i = 1; i <= 4; ++i) {
+    a.push_back(i, i + 1);   // 1/2, 2/3, 3/4, 4/5
+    b.push_back(i + 1, 2);   // 1, 3/2, 2, 5/2
+  }
+
+  RationalArray product;
+  RationalArray::multiply(a, b, product);
+  std::cout << "a[i] * b[i] =";
+  for (size_t i = 0; i < product.size(); ++i) {
+    std::cout << " " << product.at(i);
+  }
+  std::cout << "\ndot(a, b) = " << RationalArray::dot(a, b) << "\n";
+}
+
 auto main() -> int {
   try {
     // 测试两种实现方式
     testMemberOperator();
     testNonMemberOperator();
+    testRational64();
+    testCompileTimeRational();
+    testBigRational();
+    testRationalArray();
 
     // 总结：
     std::cout << "\n=== 结论 ===\n";
@@ -0,0 +1,300 @@
+#ifndef __UNITS__H
+#define __UNITS__H
+
+/**
+ * @file units.h
+ * @brief 编译期量纲检查的单位库
+ *
+ * tutorial_19 的 Distance 只认识“米”，转换成千米要在运行时做一次除法；遥测代码里米、千米、英里
+ * 混在一起，只能靠变量名区分，每个循环里都在做运行时换算。这里的做法与 std::chrono::duration 相同：
+ * - Quantity<Dim, Scale, Rep> 只保存一个 Rep，sizeof 与 Rep 相同
+ * - 量纲 Dim 和比例 Scale（std::ratio）都是类型参数：米和秒相加编译不过，
+ *   米和千米相加时先换算到公共比例
+ * - 换算系数由两个 std::ratio 在编译期约分、折叠成一个常数，浮点数换算只剩一次乘法
+ * - convert<To>(in, out, n) 批量换算连续数组，循环体与手写 out[i] = in[i] * k 相同，可以向量化
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <ratio>
+#include <type_traits>
+
+namespace units {
+
+// 量纲：长度、质量、时间的指数
+template<int L, int M, int T> struct Dimension {
+  static constexpr int length = L;
+  static constexpr int mass   = M;
+  static constexpr int time   = T;
+};
+
+using Dimensionless = Dimension<0, 0, 0>;
+using Length        = Dimension<1, 0, 0>;
+using Mass          = Dimension<0, 1, 0>;
+using Time          = Dimension<0, 0, 1>;
+using Velocity      = Dimension<1, 0, -1>;
+
+template<typename D1, typename D2>
+using DimensionProduct =
+  Dimension<D1::length + D2::length, D1::mass + D2::mass, D1::time + D2::time>;
+template<typename D1, typename D2>
+using DimensionQuotient =
+  Dimension<D1::length - D2::length, D1::mass - D2::mass, D1::time - D2::time>;
+
+template<typename Dim, typename Scale, typename Rep = double> class Quantity;
+
+namespace detail {
+
+template<typename T> struct IsRatio : std::false_type {};
+template<intmax_t N, intmax_t D> struct IsRatio<std::ratio<N, D>> : std::true_type {};
+
+// 两个比例的公共比例：分子取最大公约数，分母取最小公倍数（与 std::chrono 相同）
+template<typename S1, typename S2>
+using CommonScale = std::ratio<std::gcd(S1::num, S2::num), std::lcm(S1::den, S2::den)>;
+
+// 编译期折叠的换算：Factor = From / To，已经约分
+template<typename Factor, typename Rep> constexpr auto rescale(Rep value) -> Rep {
+  if constexpr (Factor::num == 1 && Factor::den == 1) {
+    return value;
+  }
+  else if constexpr (std::is_floating_point_v<Rep>) {
+    // 一个编译期常数，运行时只有一次乘法（与精确的除法最多相差 1 ulp）
+    constexpr Rep factor = static_cast<Rep>(Factor::num) / static_cast<Rep>(Factor::den);
+    return value * factor;
+  }
+  else if constexpr (Factor::den == 1) {
+    return static_cast<Rep>(value * static_cast<Rep>(Factor::num));
+  }
+  else if constexpr (Factor::num == 1) {
+    return static_cast<Rep>(value / static_cast<Rep>(Factor::den));
+  }
+  else {
+    using Wide = std::common_type_t<Rep, intmax_t>;
+    return static_cast<Rep>(static_cast<Wide>(value) * Factor::num / Factor::den);
+  }
+}
+
+}   // namespace detail
+
+/**
+ * 换算到另一个比例或表示类型，可能截断（整数）或舍入（浮点数）
+ * 量纲必须相同
+ */
+template<typename To, typename Dim, typename Scale, typename Rep>
+constexpr auto quantity_cast(const Quantity<Dim, Scale, Rep>& from) -> To {
+  static_assert(std::is_same_v<Dim, typename To::dimension>, "quantity_cast: dimension mismatch");
+  using ToRep  = typename To::rep;
+  using Factor = std::ratio_divide<Scale, typename To::scale>;
+  using Work   = std::common_type_t<Rep, ToRep>;
+  return To(static_cast<ToRep>(detail::rescale<Factor>(static_cast<Work>(from.count()))));
+}
+
+template<typename Dim, typename Scale, typename Rep> class Quantity {
+  static_assert(detail::IsRatio<Scale>::value, "Scale must be a std::ratio");
+  static_assert(Scale::num > 0, "Scale must be positive");
+
+  public:
+  using dimension = Dim;
+  using scale     = Scale;
+  using rep       = Rep;
+
+  constexpr Quantity() = default;
+  explicit constexpr Quantity(Rep value)
+    : value_(value) {}
+
+  // 不丢失精度的换算可以隐式进行：目标是浮点数，或者原比例是目标比例的整数倍（例如千米到米）
+  template<
+    typename Scale2,
+    typename Rep2,
+    typename = std::enable_if_t<
+      std::is_floating_point_v<Rep> ||
+      (std::ratio_divide<Scale2, Scale>::den == 1 && !std::is_floating_point_v<Rep2>)>>
+  constexpr Quantity(const Quantity<Dim, Scale2, Rep2>& other)
+    : value_(quantity_cast<Quantity>(other).count()) {}
+
+  [[nodiscard]] constexpr auto count() const -> Rep { return value_; }
+
+  constexpr auto operator+() const -> Quantity { return *this; }
+  constexpr auto operator-() const -> Quantity { return Quantity(-value_); }
+
+  constexpr auto operator+=(const Quantity& other) -> Quantity& {
+    value_ += other.value_;
+    return *this;
+  }
+  constexpr auto operator-=(const Quantity& other) -> Quantity& {
+    value_ -= other.value_;
+    return *this;
+  }
+  constexpr auto operator*=(const Rep& factor) -> Quantity& {
+    value_ *= factor;
+    return *this;
+  }
+  constexpr auto operator/=(const Rep& divisor) -> Quantity& {
+    value_ /= divisor;
+    return *this;
+  }
+
+  private:
+  Rep value_ = Rep();
+};
+
+// 同量纲、不同比例的两个量先换算到公共比例
+template<typename Dim, typename S1, typename R1, typename S2, typename R2>
+using CommonQuantity = Quantity<Dim, detail::CommonScale<S1, S2>, std::common_type_t<R1, R2>>;
+
+template<typename Dim, typename S1, typename R1, typename S2, typename R2>
+constexpr auto operator+(const Quantity<Dim, S1, R1>& a, const Quantity<Dim, S2, R2>& b)
+  -> CommonQuantity<Dim, S1, R1, S2, R2> {
+  using Common = CommonQuantity<Dim, S1, R1, S2, R2>;
+  return Common(Common(a).count() + Common(b).count());
+}
+
+template<typename Dim, typename S1, typename R1, typename S2, typename R2>
+constexpr auto operator-(const Quantity<Dim, S1, R1>& a, const Quantity<Dim, S2, R2>& b)
+  -> CommonQuantity<Dim, S1, R1, S2, R2> {
+  using Common = CommonQuantity<Dim, S1, R1, S2, R2>;
+  return Common(Common(a).count() - Common(b).count());
+}
+
+// 量与量相乘、相除：量纲的指数相加减，比例相乘除
+template<typename D1, typename S1, typename R1, typename D2, typename S2, typename R2>
+constexpr auto operator*(const Quantity<D1, S1, R1>& a, const Quantity<D2, S2, R2>& b)
+  -> Quantity<DimensionProduct<D1, D2>, std::ratio_multiply<S1, S2>, std::common_type_t<R1, R2>> {
+  using Result =
+    Quantity<DimensionProduct<D1, D2>, std::ratio_multiply<S1, S2>, std::common_type_t<R1, R2>>;
+  return Result(a.count() * b.count());
+}
+
+template<typename D1, typename S1, typename R1, typename D2, typename S2, typename R2>
+constexpr auto operator/(const Quantity<D1, S1, R1>& a, const Quantity<D2, S2, R2>& b)
+  -> Quantity<DimensionQuotient<D1, D2>, std::ratio_divide<S1, S2>, std::common_type_t<R1, R2>> {
+  using Result =
+    Quantity<DimensionQuotient<D1, D2>, std::ratio_divide<S1, S2>, std::common_type_t<R1, R2>>;
+  return Result(a.count() / b.count());
+}
+
+// 与标量相乘、相除
+// （标量参数写成 Quantity<...>::rep，不参与模板推导，所以 Meters(2.0) * 3 也能编译）
+template<typename Dim, typename Scale, typename Rep>
+constexpr auto operator*(
+  const Quantity<Dim, Scale, Rep>& q, const typename Quantity<Dim, Scale, Rep>::rep& factor)
+  -> Quantity<Dim, Scale, Rep> {
+  return Quantity<Dim, Scale, Rep>(q.count() * factor);
+}
+template<typename Dim, typename Scale, typename Rep>
+constexpr auto operator*(
+  const typename Quantity<Dim, Scale, Rep>::rep& factor, const Quantity<Dim, Scale, Rep>& q)
+  -> Quantity<Dim, Scale, Rep> {
+  return q * factor;
+}
+template<typename Dim, typename Scale, typename Rep>
+constexpr auto operator/(
+  const Quantity<Dim, Scale, Rep>& q, const typename Quantity<Dim, Scale, Rep>::rep& divisor)
+  -> Quantity<Dim, Scale, Rep> {
+  return Quantity<Dim, Scale, Rep>(q.count() / divisor);
+}
+
+// 比较同样先换算到公共比例
+template<typename Dim, typename S1, typename R1, typename S2, typename R2>
+constexpr auto operator==(const Quantity<Dim, S1, R1>& a, const Quantity<Dim, S2, R2>& b) -> bool {
+  using Common = CommonQuantity<Dim, S1, R1, S2, R2>;
+  return Common(a).count() == Common(b).count();
+}
+template<typename Dim, typename S1, typename R1, typename S2, typename R2>
+constexpr auto operator!=(const Quantity<Dim, S1, R1>& a, const Quantity<Dim, S2, R2>& b) -> bool {
+  return !(a == b);
+}
+template<typename Dim, typename S1, typename R1, typename S2, typename R2>
+constexpr auto operator<(const Quantity<Dim, S1, R1>& a, const Quantity<Dim, S2, R2>& b) -> bool {
+  using Common = CommonQuantity<Dim, S1, R1, S2, R2>;
+  return Common(a).count() < Common(b).count();
+}
+template<typename Dim, typename S1, typename R1, typename S2, typename R2>
+constexpr auto operator>(const Quantity<Dim, S1, R1>& a, const Quantity<Dim, S2, R2>& b) -> bool {
+  return b < a;
+}
+template<typename Dim, typename S1, typename R1, typename S2, typename R2>
+constexpr auto operator<=(const Quantity<Dim, S1, R1>& a, const Quantity<Dim, S2, R2>& b) -> bool {
+  return !(b < a);
+}
+template<typename Dim, typename S1, typename R1, typename S2, typename R2>
+constexpr auto operator>=(const Quantity<Dim, S1, R1>& a, const Quantity<Dim, S2, R2>& b) -> bool {
+  return !(a < b);
+}
+
+// 常用单位
+using Meters     = Quantity<Length, std::ratio<1>>;
+using Kilometers = Quantity<Length, std::kilo>;
+using Miles      = Quantity<Length, std::ratio<1'609'344, 1'000>>;   // 1 英里 = 1609.344 米
+using Seconds    = Quantity<Time, std::ratio<1>>;
+using Hours      = Quantity<Time, std::ratio<3'600>>;
+using Kilograms  = Quantity<Mass, std::ratio<1>>;
+
+using MetersPerSecond   = Quantity<Velocity, std::ratio<1>>;
+using KilometersPerHour = Quantity<Velocity, std::ratio_divide<std::kilo, std::ratio<3'600>>>;
+using MilesPerHour      = Quantity<Velocity, std::ratio_divide<Miles::scale, std::ratio<3'600>>>;
+
+static_assert(sizeof(Meters) == sizeof(double), "Quantity must add no storage");
+static_assert(std::is_trivially_copyable_v<Meters>, "Quantity must be trivially copyable");
+static_assert(std::is_standard_layout_v<Meters>, "Quantity arrays must be plain Rep arrays");
+
+/**
+ * out[i] = quantity_cast<To>(in[i])
+ * 换算系数是编译期常数，循环体与手写的 out[i] = in[i] * k 相同，编译器可以向量化
+ */
+template<typename To, typename Dim, typename Scale, typename Rep>
+void convert(const Quantity<Dim, Scale, Rep>* in, To* out, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = quantity_cast<To>(in[i]);
+  }
+}
+
+// 求和，结果保持原来的单位
+template<typename Dim, typename Scale, typename Rep>
+auto sum(const Quantity<Dim, Scale, Rep>* values, size_t count) -> Quantity<Dim, Scale, Rep> {
+  Rep total = Rep();
+  for (size_t i = 0; i < count; ++i) {
+    total += values[i].count();
+  }
+  return Quantity<Dim, Scale, Rep>(total);
+}
+
+namespace literals {
+
+constexpr auto operator""_m(long double value) -> Meters {
+  return Meters(static_cast<double>(value));
+}
+constexpr auto operator""_m(unsigned long long value) -> Meters {
+  return Meters(static_cast<double>(value));
+}
+constexpr auto operator""_km(long double value) -> Kilometers {
+  return Kilometers(static_cast<double>(value));
+}
+constexpr auto operator""_km(unsigned long long value) -> Kilometers {
+  return Kilometers(static_cast<double>(value));
+}
+constexpr auto operator""_mi(long double value) -> Miles {
+  return Miles(static_cast<double>(value));
+}
+constexpr auto operator""_mi(unsigned long long value) -> Miles {
+  return Miles(static_cast<double>(value));
+}
+constexpr auto operator""_s(long double value) -> Seconds {
+  return Seconds(static_cast<double>(value));
+}
+constexpr auto operator""_s(unsigned long long value) -> Seconds {
+  return Seconds(static_cast<double>(value));
+}
+constexpr auto operator""_h(long double value) -> Hours {
+  return Hours(static_cast<double>(value));
+}
+constexpr auto operator""_h(unsigned long long value) -> Hours {
+  return Hours(static_cast<double>(value));
+}
+
+}   // namespace literals
+
+}   // namespace units
+
+#endif